@@ -0,0 +1,422 @@
+#pragma once
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstddef>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "Scalar.hpp"
+#include "Workspace.hpp"
+
+// Kernels for large dense operations on row major arrays, which either run built in code or are handed to the
+// system BLAS and LAPACK. BLAS is only used when the library is configured with LINEAR_ALGEBRA_USE_BLAS.
+
+#ifdef LINEAR_ALGEBRA_USE_BLAS
+// Fortran BLAS and LAPACK routines. Every argument is passed by pointer, and each character argument is followed
+// at the end of the list by its hidden length.
+extern "C" {
+void sgemm_(const char *transa, const char *transb, const int *m, const int *n, const int *k, const float *alpha,
+            const float *a, const int *lda, const float *b, const int *ldb, const float *beta, float *c,
+            const int *ldc, size_t, size_t);
+void dgemm_(const char *transa, const char *transb, const int *m, const int *n, const int *k, const double *alpha,
+            const double *a, const int *lda, const double *b, const int *ldb, const double *beta, double *c,
+            const int *ldc, size_t, size_t);
+void sgemv_(const char *trans, const int *m, const int *n, const float *alpha, const float *a, const int *lda,
+            const float *x, const int *incx, const float *beta, float *y, const int *incy, size_t);
+void dgemv_(const char *trans, const int *m, const int *n, const double *alpha, const double *a, const int *lda,
+            const double *x, const int *incx, const double *beta, double *y, const int *incy, size_t);
+void sgetrf_(const int *m, const int *n, float *a, const int *lda, int *ipiv, int *info);
+void dgetrf_(const int *m, const int *n, double *a, const int *lda, int *ipiv, int *info);
+void sgetrs_(const char *trans, const int *n, const int *nrhs, const float *a, const int *lda, const int *ipiv,
+             float *b, const int *ldb, int *info, size_t);
+void dgetrs_(const char *trans, const int *n, const int *nrhs, const double *a, const int *lda, const int *ipiv,
+             double *b, const int *ldb, int *info, size_t);
+void spotrf_(const char *uplo, const int *n, float *a, const int *lda, int *info, size_t);
+void dpotrf_(const char *uplo, const int *n, double *a, const int *lda, int *info, size_t);
+void sgeqrf_(const int *m, const int *n, float *a, const int *lda, float *tau, float *work, const int *lwork,
+             int *info);
+void dgeqrf_(const int *m, const int *n, double *a, const int *lda, double *tau, double *work, const int *lwork,
+             int *info);
+void sorgqr_(const int *m, const int *n, const int *k, float *a, const int *lda, const float *tau, float *work,
+             const int *lwork, int *info);
+void dorgqr_(const int *m, const int *n, const int *k, double *a, const int *lda, const double *tau, double *work,
+             const int *lwork, int *info);
+}
+#endif
+
+namespace LinearAlgebra {
+    // Implementation used for a dense operation
+    enum class BackendKind {
+        // The library's own kernels. Available for every scalar type.
+        BuiltIn,
+        // The system BLAS and LAPACK. Only available for float and double when built with LINEAR_ALGEBRA_USE_BLAS.
+        Blas
+    };
+
+#ifdef LINEAR_ALGEBRA_USE_BLAS
+    // Whether the library was built with BLAS and LAPACK
+    inline constexpr bool BLAS_AVAILABLE = true;
+#else
+    // Whether the library was built with BLAS and LAPACK
+    inline constexpr bool BLAS_AVAILABLE = false;
+#endif
+
+    // Number of multiply-adds from which an operation is handed to BLAS. Smaller operations cost more in call
+    // overhead and layout conversion than they gain.
+    inline constexpr size_t BACKEND_MIN_OPERATIONS = 32 * 32 * 32;
+
+    // Whether BLAS can be used for values of type T
+    template<typename T>
+    inline constexpr bool blas_supported = BLAS_AVAILABLE && (std::is_same<T, float>::value ||
+                                                              std::is_same<T, double>::value);
+
+    // Returns the backend to use for an operation of the given number of multiply-adds on values of type T
+    template<typename T>
+    BackendKind select_backend(size_t operations) {
+        return blas_supported<T> && operations >= BACKEND_MIN_OPERATIONS ? BackendKind::Blas : BackendKind::BuiltIn;
+    }
+
+    namespace Detail {
+        // Scratch array taken from the current workspace
+        template<typename T>
+        using Scratch = std::pmr::vector<T>;
+
+        // Copies a rows x columns row major array into column major order
+        template<typename T>
+        void transpose_into(size_t rows, size_t columns, const T *from, T *to) {
+            for (size_t i = 0; i < rows; i++)
+                for (size_t j = 0; j < columns; j++) to[j * rows + i] = from[i * columns + j];
+        }
+
+        // Negates the rows of r and columns of q where the diagonal of r is negative, so that both backends give
+        // the unique factorisation with a non-negative diagonal
+        template<typename T>
+        void normalise_qr_signs(size_t rows, size_t columns, T *q, T *r) {
+            for (size_t i = 0; i < columns; i++) {
+                if (r[i * columns + i] >= 0) continue;
+                for (size_t j = 0; j < columns; j++) r[i * columns + j] = -r[i * columns + j];
+                for (size_t j = 0; j < rows; j++) q[j * columns + i] = -q[j * columns + i];
+            }
+        }
+
+        // Throws std::logic_error when BLAS was requested for a type or build which does not support it
+        [[noreturn]] inline void blas_unavailable() {
+            throw std::logic_error("BLAS backend is not available for this type or build");
+        }
+    }
+
+    // The library's own kernels. Arrays are row major and tightly packed.
+    namespace BuiltIn {
+        // c = a b, where a is rows x inner and b is inner x columns. Accumulates in accumulator_t<T>.
+        template<typename T>
+        void gemm(size_t rows, size_t inner, size_t columns, const T *a, const T *b, T *c) {
+            Detail::Scratch<accumulator_t<T>> row(columns, Workspace::resource());
+            for (size_t i = 0; i < rows; i++) {
+                std::fill(row.begin(), row.end(), 0);
+                for (size_t k = 0; k < inner; k++) {
+                    auto value = (accumulator_t<T>) a[i * inner + k];
+                    for (size_t j = 0; j < columns; j++) row[j] += value * (accumulator_t<T>) b[k * columns + j];
+                }
+                for (size_t j = 0; j < columns; j++) c[i * columns + j] = (T) row[j];
+            }
+        }
+
+        // y = a x, where a is rows x columns. Accumulates in accumulator_t<T>.
+        template<typename T>
+        void gemv(size_t rows, size_t columns, const T *a, const T *x, T *y) {
+            for (size_t i = 0; i < rows; i++) {
+                accumulator_t<T> accumulator = 0;
+                for (size_t j = 0; j < columns; j++)
+                    accumulator += (accumulator_t<T>) a[i * columns + j] * (accumulator_t<T>) x[j];
+                y[i] = (T) accumulator;
+            }
+        }
+
+        // Solves a x = b by LU decomposition with partial pivoting, where a is n x n and b is n x count.
+        // a is overwritten by its factors and b by the solution.
+        // Throws std::invalid_argument if a is singular.
+        template<typename T>
+        void lu_solve(size_t n, T *a, size_t count, T *b) {
+            static_assert(!std::is_integral<T>::value, "Cannot solve an integral system by elimination.");
+            for (size_t c = 0; c < n; c++) {
+                size_t pivot = c;
+                for (size_t i = c + 1; i < n; i++) if (std::abs(a[i * n + c]) > std::abs(a[pivot * n + c])) pivot = i;
+                if (a[pivot * n + c] == 0)
+                    throw std::invalid_argument("Cannot solve a singular system");
+                if (pivot != c) {
+                    std::swap_ranges(a + pivot * n, a + pivot * n + n, a + c * n);
+                    std::swap_ranges(b + pivot * count, b + pivot * count + count, b + c * count);
+                }
+
+                for (size_t i = c + 1; i < n; i++) {
+                    T factor = a[i * n + c] / a[c * n + c];
+                    for (size_t j = c; j < n; j++) a[i * n + j] -= factor * a[c * n + j];
+                    for (size_t j = 0; j < count; j++) b[i * count + j] -= factor * b[c * count + j];
+                }
+            }
+            for (size_t c = n; c-- > 0;) {
+                for (size_t j = 0; j < count; j++) {
+                    T accumulator = b[c * count + j];
+                    for (size_t k = c + 1; k < n; k++) accumulator -= a[c * n + k] * b[k * count + j];
+                    b[c * count + j] = accumulator / a[c * n + c];
+                }
+            }
+        }
+
+        // Replaces the symmetric n x n matrix a with the lower triangular l where a = l lᵀ.
+        // Throws std::invalid_argument if a is not positive definite.
+        template<typename T>
+        void cholesky(size_t n, T *a) {
+            static_assert(!std::is_integral<T>::value, "Cannot take the Cholesky decomposition of an integral matrix.");
+            for (size_t j = 0; j < n; j++) {
+                T diagonal = a[j * n + j];
+                for (size_t k = 0; k < j; k++) diagonal -= a[j * n + k] * a[j * n + k];
+                if (!(diagonal > 0))
+                    throw std::invalid_argument("Matrix is not positive definite");
+                diagonal = std::sqrt(diagonal);
+                a[j * n + j] = diagonal;
+
+                for (size_t i = j + 1; i < n; i++) {
+                    T accumulator = a[i * n + j];
+                    for (size_t k = 0; k < j; k++) accumulator -= a[i * n + k] * a[j * n + k];
+                    a[i * n + j] = accumulator / diagonal;
+                }
+                for (size_t i = j + 1; i < n; i++) a[j * n + i] = 0;
+            }
+        }
+
+        // Factorises the rows x columns matrix a into q r by Householder reflections, where q is rows x columns
+        // with orthonormal columns and r is columns x columns upper triangular with a non-negative diagonal.
+        // Throws std::invalid_argument if a has more columns than rows.
+        template<typename T>
+        void qr(size_t rows, size_t columns, const T *a, T *q, T *r) {
+            static_assert(!std::is_integral<T>::value, "Cannot take the QR decomposition of an integral matrix.");
+            if (rows < columns)
+                throw std::invalid_argument("QR decomposition needs at least as many rows as columns");
+
+            // Householder vectors, one per column, each stored from the diagonal down
+            Detail::Scratch<T> reduced(a, a + rows * columns, Workspace::resource());
+            Detail::Scratch<T> reflectors(rows * columns, T(0), Workspace::resource());
+            for (size_t k = 0; k < columns; k++) {
+                T *v = reflectors.data() + k * rows;
+                T norm = 0;
+                for (size_t i = k; i < rows; i++) norm += reduced[i * columns + k] * reduced[i * columns + k];
+                norm = std::sqrt(norm);
+                if (norm == 0) continue;
+
+                T alpha = reduced[k * columns + k] > 0 ? -norm : norm;
+                for (size_t i = k; i < rows; i++) v[i] = reduced[i * columns + k];
+                v[k] -= alpha;
+                T length = 0;
+                for (size_t i = k; i < rows; i++) length += v[i] * v[i];
+                length = std::sqrt(length);
+                for (size_t i = k; i < rows; i++) v[i] /= length;
+
+                for (size_t j = k; j < columns; j++) {
+                    T dot = 0;
+                    for (size_t i = k; i < rows; i++) dot += v[i] * reduced[i * columns + j];
+                    for (size_t i = k; i < rows; i++) reduced[i * columns + j] -= 2 * dot * v[i];
+                }
+            }
+
+            for (size_t i = 0; i < columns; i++)
+                for (size_t j = 0; j < columns; j++) r[i * columns + j] = j >= i ? reduced[i * columns + j] : 0;
+
+            // q is the first columns of the product of the reflectors, applied to the identity in reverse
+            for (size_t i = 0; i < rows; i++) for (size_t j = 0; j < columns; j++) q[i * columns + j] = i == j;
+            for (size_t k = columns; k-- > 0;) {
+                const T *v = reflectors.data() + k * rows;
+                for (size_t j = 0; j < columns; j++) {
+                    T dot = 0;
+                    for (size_t i = k; i < rows; i++) dot += v[i] * q[i * columns + j];
+                    for (size_t i = k; i < rows; i++) q[i * columns + j] -= 2 * dot * v[i];
+                }
+            }
+            Detail::normalise_qr_signs(rows, columns, q, r);
+        }
+    }
+
+#ifdef LINEAR_ALGEBRA_USE_BLAS
+    // The system BLAS and LAPACK, with the same interface as the built in kernels. Row major arrays are passed to
+    // the column major routines as their transposes, and converted where a routine cannot be told to transpose.
+    namespace Blas {
+        // Converts a dimension to the int the Fortran routines take.
+        // Throws std::invalid_argument if it is too large to pass.
+        inline int dimension(size_t extent) {
+            if (extent > (size_t) INT_MAX)
+                throw std::invalid_argument("Matrix dimension is too large for BLAS");
+            return (int) extent;
+        }
+
+        // Throws std::invalid_argument if a LAPACK routine reported that one of its arguments was illegal
+        inline void check_arguments(int info, const char *routine) {
+            if (info < 0)
+                throw std::invalid_argument(std::string(routine) + " rejected argument " + std::to_string(-info));
+        }
+
+        // c = a b, computed as cᵀ = bᵀ aᵀ.
+        // Throws std::invalid_argument if a dimension is too large to pass.
+        template<typename T>
+        void gemm(size_t rows, size_t inner, size_t columns, const T *a, const T *b, T *c) {
+            int m = dimension(columns), n = dimension(rows), k = dimension(inner);
+            T one = 1, zero = 0;
+            if constexpr (std::is_same<T, float>::value)
+                sgemm_("N", "N", &m, &n, &k, &one, b, &m, a, &k, &zero, c, &m, 1, 1);
+            else
+                dgemm_("N", "N", &m, &n, &k, &one, b, &m, a, &k, &zero, c, &m, 1, 1);
+        }
+
+        // y = a x, using the row major a as the transpose of a column major matrix.
+        // Throws std::invalid_argument if a dimension is too large to pass.
+        template<typename T>
+        void gemv(size_t rows, size_t columns, const T *a, const T *x, T *y) {
+            int m = dimension(columns), n = dimension(rows), increment = 1;
+            T one = 1, zero = 0;
+            if constexpr (std::is_same<T, float>::value)
+                sgemv_("T", &m, &n, &one, a, &m, x, &increment, &zero, y, &increment, 1);
+            else
+                dgemv_("T", &m, &n, &one, a, &m, x, &increment, &zero, y, &increment, 1);
+        }
+
+        // Solves a x = b by factorising aᵀ and solving with the transposed factors.
+        // Throws std::invalid_argument if a is singular, a dimension is too large or LAPACK rejects an argument.
+        template<typename T>
+        void lu_solve(size_t n, T *a, size_t count, T *b) {
+            int size = dimension(n), right = dimension(count), info = 0;
+            Detail::Scratch<int> pivots(n, Workspace::resource());
+            Detail::Scratch<T> solution(n * count, Workspace::resource());
+            Detail::transpose_into(n, count, b, solution.data());
+
+            if constexpr (std::is_same<T, float>::value) sgetrf_(&size, &size, a, &size, pivots.data(), &info);
+            else dgetrf_(&size, &size, a, &size, pivots.data(), &info);
+            check_arguments(info, "getrf");
+            if (info > 0)
+                throw std::invalid_argument("Cannot solve a singular system");
+            if constexpr (std::is_same<T, float>::value)
+                sgetrs_("T", &size, &right, a, &size, pivots.data(), solution.data(), &size, &info, 1);
+            else
+                dgetrs_("T", &size, &right, a, &size, pivots.data(), solution.data(), &size, &info, 1);
+            check_arguments(info, "getrs");
+
+            Detail::transpose_into(count, n, solution.data(), b);
+        }
+
+        // Factorises a in place. The upper factor of the column major matrix is the lower factor of the row major one.
+        // Throws std::invalid_argument if a is not positive definite, n is too large or LAPACK rejects an argument.
+        template<typename T>
+        void cholesky(size_t n, T *a) {
+            int size = dimension(n), info = 0;
+            if constexpr (std::is_same<T, float>::value) spotrf_("U", &size, a, &size, &info, 1);
+            else dpotrf_("U", &size, a, &size, &info, 1);
+            check_arguments(info, "potrf");
+            if (info > 0)
+                throw std::invalid_argument("Matrix is not positive definite");
+            for (size_t i = 0; i < n; i++) for (size_t j = i + 1; j < n; j++) a[i * n + j] = 0;
+        }
+
+        // Factorises a into q r with geqrf and orgqr on a column major copy.
+        // Throws std::invalid_argument if a has more columns than rows, a dimension is too large or LAPACK rejects
+        // an argument.
+        template<typename T>
+        void qr(size_t rows, size_t columns, const T *a, T *q, T *r) {
+            if (rows < columns)
+                throw std::invalid_argument("QR decomposition needs at least as many rows as columns");
+            int m = dimension(rows), n = dimension(columns), info = 0, query = -1;
+            Detail::Scratch<T> factors(rows * columns, Workspace::resource()), tau(columns, Workspace::resource());
+            Detail::transpose_into(rows, columns, a, factors.data());
+
+            // Asks each routine for its preferred work array size before running it
+            T size = 0;
+            if constexpr (std::is_same<T, float>::value)
+                sgeqrf_(&m, &n, factors.data(), &m, tau.data(), &size, &query, &info);
+            else
+                dgeqrf_(&m, &n, factors.data(), &m, tau.data(), &size, &query, &info);
+            check_arguments(info, "geqrf");
+            int length = std::max((int) size, n);
+            Detail::Scratch<T> work(length, Workspace::resource());
+            if constexpr (std::is_same<T, float>::value)
+                sgeqrf_(&m, &n, factors.data(), &m, tau.data(), work.data(), &length, &info);
+            else
+                dgeqrf_(&m, &n, factors.data(), &m, tau.data(), work.data(), &length, &info);
+            check_arguments(info, "geqrf");
+
+            for (size_t i = 0; i < columns; i++)
+                for (size_t j = 0; j < columns; j++) r[i * columns + j] = j >= i ? factors[j * rows + i] : 0;
+
+            if constexpr (std::is_same<T, float>::value)
+                sorgqr_(&m, &n, &n, factors.data(), &m, tau.data(), &size, &query, &info);
+            else
+                dorgqr_(&m, &n, &n, factors.data(), &m, tau.data(), &size, &query, &info);
+            check_arguments(info, "orgqr");
+            length = std::max((int) size, n);
+            work.resize(length);
+            if constexpr (std::is_same<T, float>::value)
+                sorgqr_(&m, &n, &n, factors.data(), &m, tau.data(), work.data(), &length, &info);
+            else
+                dorgqr_(&m, &n, &n, factors.data(), &m, tau.data(), work.data(), &length, &info);
+            check_arguments(info, "orgqr");
+
+            Detail::transpose_into(columns, rows, factors.data(), q);
+            Detail::normalise_qr_signs(rows, columns, q, r);
+        }
+    }
+#endif
+
+    // Dense operations on row major arrays, run by the chosen backend. Each has the interface of the built in
+    // kernel of the same name. Throw std::logic_error if BLAS is chosen but unavailable for T.
+    namespace Backend {
+        // c = a b, where a is rows x inner and b is inner x columns
+        template<typename T>
+        void gemm(BackendKind kind, size_t rows, size_t inner, size_t columns, const T *a, const T *b, T *c) {
+            if (kind == BackendKind::BuiltIn) return BuiltIn::gemm(rows, inner, columns, a, b, c);
+#ifdef LINEAR_ALGEBRA_USE_BLAS
+            if constexpr (blas_supported<T>) return Blas::gemm(rows, inner, columns, a, b, c);
+#endif
+            Detail::blas_unavailable();
+        }
+
+        // y = a x, where a is rows x columns
+        template<typename T>
+        void gemv(BackendKind kind, size_t rows, size_t columns, const T *a, const T *x, T *y) {
+            if (kind == BackendKind::BuiltIn) return BuiltIn::gemv(rows, columns, a, x, y);
+#ifdef LINEAR_ALGEBRA_USE_BLAS
+            if constexpr (blas_supported<T>) return Blas::gemv(rows, columns, a, x, y);
+#endif
+            Detail::blas_unavailable();
+        }
+
+        // Solves a x = b, where a is n x n and b is n x count, overwriting a with its factors and b with x
+        template<typename T>
+        void lu_solve(BackendKind kind, size_t n, T *a, size_t count, T *b) {
+            if (kind == BackendKind::BuiltIn) return BuiltIn::lu_solve(n, a, count, b);
+#ifdef LINEAR_ALGEBRA_USE_BLAS
+            if constexpr (blas_supported<T>) return Blas::lu_solve(n, a, count, b);
+#endif
+            Detail::blas_unavailable();
+        }
+
+        // Replaces the symmetric positive definite n x n matrix a with its lower Cholesky factor
+        template<typename T>
+        void cholesky(BackendKind kind, size_t n, T *a) {
+            if (kind == BackendKind::BuiltIn) return BuiltIn::cholesky(n, a);
+#ifdef LINEAR_ALGEBRA_USE_BLAS
+            if constexpr (blas_supported<T>) return Blas::cholesky(n, a);
+#endif
+            Detail::blas_unavailable();
+        }
+
+        // Factorises the rows x columns matrix a into q r with a non-negative diagonal in r
+        template<typename T>
+        void qr(BackendKind kind, size_t rows, size_t columns, const T *a, T *q, T *r) {
+            if (kind == BackendKind::BuiltIn) return BuiltIn::qr(rows, columns, a, q, r);
+#ifdef LINEAR_ALGEBRA_USE_BLAS
+            if constexpr (blas_supported<T>) return Blas::qr(rows, columns, a, q, r);
+#endif
+            Detail::blas_unavailable();
+        }
+    }
+}
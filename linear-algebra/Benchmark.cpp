@@ -0,0 +1,203 @@
+#include <linear-algebra/Vector.hpp>
+#include <linear-algebra/Matrix.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+using namespace LinearAlgebra;
+
+// Hot path kernels, kept out of line so their code can be read with
+// `objdump -d --no-show-raw-insn linear-algebra-benchmark | c++filt` and checked for loops and redundant stores.
+namespace Kernel {
+    [[gnu::noinline]] Mat4 mat4_multiply(const Mat4 &a, const Mat4 &b) {
+        return a * b;
+    }
+
+    [[gnu::noinline]] Vec4 mat4_multiply_vector(const Mat4 &a, const Vec4 &v) {
+        return a * v;
+    }
+
+    [[gnu::noinline]] Mat4 mat4_plus(const Mat4 &a, const Mat4 &b) {
+        return a + b;
+    }
+
+    [[gnu::noinline]] Mat4 mat4_scale(const Mat4 &a, double m) {
+        return a * m;
+    }
+
+    [[gnu::noinline]] Mat4 mat4_transpose(const Mat4 &a) {
+        return a.transpose();
+    }
+
+    [[gnu::noinline]] Vec4 vec4_plus(const Vec4 &a, const Vec4 &b) {
+        return a + b;
+    }
+
+    [[gnu::noinline]] double vec4_dot_product(const Vec4 &a, const Vec4 &b) {
+        return a.dot_product(b);
+    }
+}
+
+// The kernels as they were written before unrolling: a default constructed result, which is the identity or zero,
+// filled by loops with runtime counters. Kept as the baseline the unrolled kernels are measured against.
+namespace Looped {
+    [[gnu::noinline]] Mat4 mat4_multiply(const Mat4 &a, const Mat4 &b) {
+        Mat4 multiply;
+        for (int i = 0; i < 4; i++) {
+            for (int j = 0; j < 4; j++) {
+                double accumulator = 0;
+                for (int k = 0; k < 4; k++) accumulator += a[i][k] * b[k][j];
+                multiply[i][j] = accumulator;
+            }
+        }
+        return multiply;
+    }
+
+    [[gnu::noinline]] Vec4 mat4_multiply_vector(const Mat4 &a, const Vec4 &v) {
+        Vec4 multiply;
+        for (int i = 0; i < 4; i++) {
+            double accumulator = 0;
+            for (int j = 0; j < 4; j++) accumulator += a[i][j] * v[j];
+            multiply[i] = accumulator;
+        }
+        return multiply;
+    }
+
+    [[gnu::noinline]] Mat4 mat4_plus(const Mat4 &a, const Mat4 &b) {
+        Mat4 sum;
+        for (int i = 0; i < 4; i++) for (int j = 0; j < 4; j++) sum[i][j] = a[i][j] + b[i][j];
+        return sum;
+    }
+
+    [[gnu::noinline]] Mat4 mat4_scale(const Mat4 &a, double m) {
+        Mat4 scaled;
+        for (int i = 0; i < 4; i++) for (int j = 0; j < 4; j++) scaled[i][j] = m * a[i][j];
+        return scaled;
+    }
+
+    [[gnu::noinline]] Mat4 mat4_transpose(const Mat4 &a) {
+        Mat4 transpose;
+        for (int i = 0; i < 4; i++) for (int j = 0; j < 4; j++) transpose[i][j] = a[j][i];
+        return transpose;
+    }
+
+    [[gnu::noinline]] Vec4 vec4_plus(const Vec4 &a, const Vec4 &b) {
+        Vec4 sum;
+        for (int i = 0; i < 4; i++) sum[i] = a[i] + b[i];
+        return sum;
+    }
+
+    [[gnu::noinline]] double vec4_dot_product(const Vec4 &a, const Vec4 &b) {
+        double accumulator = 0;
+        for (int i = 0; i < 4; i++) accumulator += a[i] * b[i];
+        return accumulator;
+    }
+}
+
+constexpr unsigned int ITERATIONS = 2000000;
+constexpr unsigned int REPEATS = 15;
+
+// Stops the compiler from discarding or hoisting a result
+template<typename T>
+void keep(T &value) {
+    asm volatile("" : : "r"(&value) : "memory");
+}
+
+// Returns the mean time of one call of f in nanoseconds
+template<typename F>
+double time(F f) {
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned int n = 0; n < ITERATIONS; n++) f();
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / ITERATIONS;
+}
+
+// Prints the time of the unrolled and looped versions of a kernel. The two are timed in alternating runs and the
+// fastest run of each is kept, to filter out noise from the rest of the system.
+template<typename U, typename L>
+void compare(const char *name, U unrolled, L looped) {
+    double u = time(unrolled), l = time(looped);
+    for (unsigned int n = 1; n < REPEATS; n++) {
+        u = std::min(u, time(unrolled));
+        l = std::min(l, time(looped));
+    }
+    std::cout << std::left << std::setw(24) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(10) << u << " ns" << std::setw(10) << l << " ns" << std::setw(9) << l / u << "x"
+              << std::endl;
+}
+
+int main() {
+    Mat4 a([](int i, int j) { return 1.0 + i * 4 + j; });
+    Mat4 b([](int i, int j) { return 0.5 * (i + 1) - j; });
+    Vec4 u{1, 2, 3, 4}, v{4, 3, 2, 1};
+    double m = 1.5;
+
+    std::cout << std::left << std::setw(24) << "kernel" << std::right << std::setw(13) << "unrolled"
+              << std::setw(13) << "looped" << std::setw(10) << "speedup" << std::endl;
+    compare("Mat4 * Mat4", [&] {
+        keep(a);
+        Mat4 r = Kernel::mat4_multiply(a, b);
+        keep(r);
+    }, [&] {
+        keep(a);
+        Mat4 r = Looped::mat4_multiply(a, b);
+        keep(r);
+    });
+    compare("Mat4 * Vec4", [&] {
+        keep(a);
+        Vec4 r = Kernel::mat4_multiply_vector(a, u);
+        keep(r);
+    }, [&] {
+        keep(a);
+        Vec4 r = Looped::mat4_multiply_vector(a, u);
+        keep(r);
+    });
+    compare("Mat4 + Mat4", [&] {
+        keep(a);
+        Mat4 r = Kernel::mat4_plus(a, b);
+        keep(r);
+    }, [&] {
+        keep(a);
+        Mat4 r = Looped::mat4_plus(a, b);
+        keep(r);
+    });
+    compare("Mat4 * scalar", [&] {
+        keep(a);
+        Mat4 r = Kernel::mat4_scale(a, m);
+        keep(r);
+    }, [&] {
+        keep(a);
+        Mat4 r = Looped::mat4_scale(a, m);
+        keep(r);
+    });
+    compare("Mat4 transpose", [&] {
+        keep(a);
+        Mat4 r = Kernel::mat4_transpose(a);
+        keep(r);
+    }, [&] {
+        keep(a);
+        Mat4 r = Looped::mat4_transpose(a);
+        keep(r);
+    });
+    compare("Vec4 + Vec4", [&] {
+        keep(u);
+        Vec4 r = Kernel::vec4_plus(u, v);
+        keep(r);
+    }, [&] {
+        keep(u);
+        Vec4 r = Looped::vec4_plus(u, v);
+        keep(r);
+    });
+    compare("Vec4 dot Vec4", [&] {
+        keep(u);
+        double r = Kernel::vec4_dot_product(u, v);
+        keep(r);
+    }, [&] {
+        keep(u);
+        double r = Looped::vec4_dot_product(u, v);
+        keep(r);
+    });
+    return 0;
+}
@@ -0,0 +1,204 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include "Vector.hpp"
+#include "Matrix.hpp"
+#include "Parallel.hpp"
+
+namespace LinearAlgebra {
+    // An axis aligned box of size S described by its minimum and maximum corners
+    template<unsigned int S, typename T = double>
+    struct AxisAlignedBox {
+        Vector<S, T> min, max;
+
+        // Default constructor. Creates a box containing only the origin.
+        AxisAlignedBox() = default;
+
+        // Construct from the minimum and maximum corners
+        AxisAlignedBox(const Vector<S, T> &min, const Vector<S, T> &max) : min(min), max(max) {}
+
+        // Returns the centre of the box
+        Vector<S, T> centre() const {
+            return (min + max) * (T) 0.5;
+        }
+
+        // Returns half the size of the box along each axis
+        Vector<S, T> half_extent() const {
+            return (max - min) * (T) 0.5;
+        }
+
+        // Returns whether the point lies within the box, including its boundary
+        bool contains(const Vector<S, T> &point) const {
+            for (int i = 0; i < S; i++) if (point[i] < min[i] || point[i] > max[i]) return false;
+            return true;
+        }
+
+        // Returns the smallest axis aligned box containing this box after an affine transform in homogeneous
+        // coordinates. Uses Arvo's method, which needs 2 multiplies per matrix entry rather than transforming
+        // all 2^S corners.
+        AxisAlignedBox transformed(const Matrix<S + 1, S + 1, T> &m) const {
+            AxisAlignedBox box;
+            for (int i = 0; i < S; i++) {
+                box.min[i] = box.max[i] = m[i][S];
+                for (int j = 0; j < S; j++) {
+                    T a = m[i][j] * min[j], b = m[i][j] * max[j];
+                    box.min[i] += std::min(a, b);
+                    box.max[i] += std::max(a, b);
+                }
+            }
+            return box;
+        }
+
+        // Returns the smallest axis aligned box containing this box after a linear transform
+        AxisAlignedBox transformed(const Matrix<S, S, T> &m) const {
+            AxisAlignedBox box;
+            for (int i = 0; i < S; i++) {
+                box.min[i] = box.max[i] = 0;
+                for (int j = 0; j < S; j++) {
+                    T a = m[i][j] * min[j], b = m[i][j] * max[j];
+                    box.min[i] += std::min(a, b);
+                    box.max[i] += std::max(a, b);
+                }
+            }
+            return box;
+        }
+    };
+
+    // Boxes stored as separate arrays of each coordinate of their minimum and maximum corners
+    template<typename T = double>
+    struct BoxArrays {
+        std::span<const T> min_x, min_y, min_z, max_x, max_y, max_z;
+    };
+
+    // Spheres stored as separate arrays of each coordinate of their centre and their radius
+    template<typename T = double>
+    struct SphereArrays {
+        std::span<const T> centre_x, centre_y, centre_z, radius;
+    };
+
+    // A view frustum described by 6 inward facing planes (a, b, c, d), where ax + by + cz + d >= 0 inside.
+    template<typename T = double>
+    struct Frustum {
+        // Left, right, bottom, top, near and far planes, each with a unit normal
+        std::array<Vector<4, T>, 6> planes;
+
+        // Extracts the frustum planes from a view projection matrix with clip space z in [-w, w]
+        static Frustum from_matrix(const Matrix<4, 4, T> &m) {
+            Frustum frustum;
+            for (int p = 0; p < 6; p++) {
+                int row = p / 2;
+                T sign = p % 2 == 0 ? 1 : -1;
+                Vector<4, T> plane;
+                for (int j = 0; j < 4; j++) plane[j] = m[3][j] + sign * m[row][j];
+                T length = std::sqrt(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+                frustum.planes[p] = plane * (1 / length);
+            }
+            return frustum;
+        }
+
+        // Returns whether any part of the box may be inside the frustum. Conservative near the frustum corners.
+        bool intersects(const AxisAlignedBox<3, T> &box) const {
+            Vector<3, T> c = box.centre(), e = box.half_extent();
+            for (const auto &plane: planes) {
+                T distance = plane[0] * c[0] + plane[1] * c[1] + plane[2] * c[2] + plane[3];
+                T radius = std::abs(plane[0]) * e[0] + std::abs(plane[1]) * e[1] + std::abs(plane[2]) * e[2];
+                if (distance + radius < 0) return false;
+            }
+            return true;
+        }
+
+        // Returns whether any part of the sphere may be inside the frustum. Conservative near the frustum corners.
+        bool intersects(const Vector<3, T> &centre, T radius) const {
+            for (const auto &plane: planes) {
+                T distance = plane[0] * centre[0] + plane[1] * centre[1] + plane[2] * centre[2] + plane[3];
+                if (distance + radius < 0) return false;
+            }
+            return true;
+        }
+
+    private:
+        // Number of objects tested together before their visible indices are gathered
+        static constexpr size_t BLOCK = 1024;
+
+        // Runs test(begin, end, mask) over blocks of objects across threads, writing 1 into mask for each visible
+        // object, and returns the indices of the visible objects in ascending order.
+        template<typename F>
+        static std::vector<unsigned int> gather_visible(size_t count, F test) {
+            size_t blocks = (count + BLOCK - 1) / BLOCK;
+            std::vector<std::vector<unsigned int>> visible(blocks);
+
+            parallel_for(blocks, [&](size_t first_block, size_t last_block) {
+                uint8_t mask[BLOCK];
+                for (size_t b = first_block; b < last_block; b++) {
+                    size_t begin = b * BLOCK, end = std::min(count, begin + BLOCK);
+                    test(begin, end, mask);
+                    for (size_t n = begin; n < end; n++)
+                        if (mask[n - begin]) visible[b].push_back((unsigned int) n);
+                }
+            }, 16);
+
+            std::vector<unsigned int> indices;
+            for (const auto &block: visible) indices.insert(indices.end(), block.begin(), block.end());
+            return indices;
+        }
+
+    public:
+        // Tests every box against the frustum and returns the indices of those which may be visible.
+        // The plane tests are branch free over contiguous arrays so the compiler can vectorise them.
+        // Throws std::invalid_argument if the arrays differ in length.
+        std::vector<unsigned int> cull(const BoxArrays<T> &boxes) const {
+            size_t count = boxes.min_x.size();
+            if (boxes.min_y.size() != count || boxes.min_z.size() != count || boxes.max_x.size() != count ||
+                boxes.max_y.size() != count || boxes.max_z.size() != count)
+                throw std::invalid_argument("Box arrays must all have the same length");
+
+            return gather_visible(count, [&](size_t begin, size_t end, uint8_t *mask) {
+                for (size_t n = begin; n < end; n++) mask[n - begin] = 1;
+                for (const auto &plane: planes) {
+                    T ax = std::abs(plane[0]), ay = std::abs(plane[1]), az = std::abs(plane[2]);
+                    for (size_t n = begin; n < end; n++) {
+                        T cx = boxes.min_x[n] + boxes.max_x[n], ex = boxes.max_x[n] - boxes.min_x[n];
+                        T cy = boxes.min_y[n] + boxes.max_y[n], ey = boxes.max_y[n] - boxes.min_y[n];
+                        T cz = boxes.min_z[n] + boxes.max_z[n], ez = boxes.max_z[n] - boxes.min_z[n];
+                        // Both distance and radius are doubled, avoiding halving the centre and extent
+                        T distance = plane[0] * cx + plane[1] * cy + plane[2] * cz + 2 * plane[3];
+                        T radius = ax * ex + ay * ey + az * ez;
+                        mask[n - begin] &= (uint8_t) (distance + radius >= 0);
+                    }
+                }
+            });
+        }
+
+        // Tests every sphere against the frustum and returns the indices of those which may be visible.
+        // Throws std::invalid_argument if the arrays differ in length.
+        std::vector<unsigned int> cull(const SphereArrays<T> &spheres) const {
+            size_t count = spheres.centre_x.size();
+            if (spheres.centre_y.size() != count || spheres.centre_z.size() != count ||
+                spheres.radius.size() != count)
+                throw std::invalid_argument("Sphere arrays must all have the same length");
+
+            return gather_visible(count, [&](size_t begin, size_t end, uint8_t *mask) {
+                for (size_t n = begin; n < end; n++) mask[n - begin] = 1;
+                for (const auto &plane: planes) {
+                    for (size_t n = begin; n < end; n++) {
+                        T distance = plane[0] * spheres.centre_x[n] + plane[1] * spheres.centre_y[n] +
+                                     plane[2] * spheres.centre_z[n] + plane[3];
+                        mask[n - begin] &= (uint8_t) (distance + spheres.radius[n] >= 0);
+                    }
+                }
+            });
+        }
+    };
+
+    // Aliases for common types
+    using Box2 = AxisAlignedBox<2, double>;
+    using Box3 = AxisAlignedBox<3, double>;
+    using Box2f = AxisAlignedBox<2, float>;
+    using Box3f = AxisAlignedBox<3, float>;
+}
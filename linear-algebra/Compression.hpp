@@ -0,0 +1,240 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include "Vector.hpp"
+#include "Orientation.hpp"
+#include "Parallel.hpp"
+
+namespace LinearAlgebra {
+    namespace Detail {
+        // Maps a value in [-1, 1] onto an unsigned integer of the given number of bits
+        template<unsigned int BITS>
+        inline uint32_t quantise_unit(double v) {
+            constexpr double MAX = (1u << BITS) - 1;
+            return (uint32_t) std::lround((std::clamp(v, -1.0, 1.0) * 0.5 + 0.5) * MAX);
+        }
+
+        // Inverse of quantise_unit
+        template<unsigned int BITS>
+        inline double dequantise_unit(uint32_t q) {
+            constexpr double MAX = (1u << BITS) - 1;
+            return (double) q / MAX * 2.0 - 1.0;
+        }
+
+        // Encodes a unit quaternion as the index of its largest component and the other three, each with BITS bits.
+        // The quaternion is negated if needed so that the dropped component is positive.
+        template<unsigned int BITS>
+        inline uint64_t pack_smallest_three(const Quaternion &q) {
+            double values[4] = {q.r, q.i, q.j, q.k};
+            unsigned int largest = 0;
+            for (unsigned int c = 1; c < 4; c++) if (std::abs(values[c]) > std::abs(values[largest])) largest = c;
+            double sign = values[largest] < 0 ? -1.0 : 1.0;
+
+            uint64_t bits = largest;
+            unsigned int shift = 2;
+            for (unsigned int c = 0; c < 4; c++) {
+                if (c == largest) continue;
+                bits |= (uint64_t) quantise_unit<BITS>(sign * values[c] * M_SQRT2) << shift;
+                shift += BITS;
+            }
+            return bits;
+        }
+
+        // Inverse of pack_smallest_three
+        template<unsigned int BITS>
+        inline Quaternion unpack_smallest_three(uint64_t bits) {
+            double values[4];
+            auto largest = (unsigned int) (bits & 3);
+            double sum_squares = 0;
+            unsigned int shift = 2;
+            for (unsigned int c = 0; c < 4; c++) {
+                if (c == largest) continue;
+                values[c] = dequantise_unit<BITS>((bits >> shift) & ((1u << BITS) - 1)) * M_SQRT1_2;
+                sum_squares += values[c] * values[c];
+                shift += BITS;
+            }
+            values[largest] = sqrt(std::max(0.0, 1.0 - sum_squares));
+            return {values[0], values[1], values[2], values[3]};
+        }
+    }
+
+    // A unit quaternion stored in 4 bytes using the smallest three encoding.
+    // As a 4 vector the decoded quaternion is within 2.5e-3 of the original, or its negation.
+    struct PackedQuaternion32 {
+        uint32_t bits;
+
+        // Encodes a unit quaternion
+        static PackedQuaternion32 encode(const Quaternion &q) {
+            return {(uint32_t) Detail::pack_smallest_three<10>(q)};
+        }
+
+        // Decodes into a unit quaternion. May be the negation of the encoded quaternion, which is the same rotation.
+        Quaternion decode() const {
+            return Detail::unpack_smallest_three<10>(bits);
+        }
+    };
+
+    // A unit quaternion stored in 6 bytes using the smallest three encoding.
+    // As a 4 vector the decoded quaternion is within 1e-4 of the original, or its negation.
+    struct PackedQuaternion48 {
+        uint16_t words[3];
+
+        // Encodes a unit quaternion
+        static PackedQuaternion48 encode(const Quaternion &q) {
+            uint64_t bits = Detail::pack_smallest_three<15>(q);
+            return {{(uint16_t) bits, (uint16_t) (bits >> 16), (uint16_t) (bits >> 32)}};
+        }
+
+        // Decodes into a unit quaternion. May be the negation of the encoded quaternion, which is the same rotation.
+        Quaternion decode() const {
+            uint64_t bits = (uint64_t) words[0] | (uint64_t) words[1] << 16 | (uint64_t) words[2] << 32;
+            return Detail::unpack_smallest_three<15>(bits);
+        }
+    };
+
+    // A unit direction stored in 4 bytes using the octahedral encoding.
+    // The decoded direction is within 1e-4 radians of the original.
+    struct PackedDirection {
+        int16_t x, y;
+
+        // Encodes a unit vector. The zero vector has no direction and is encoded as +Z.
+        static PackedDirection encode(const Vec3 &v) {
+            double l1 = std::abs(v[0]) + std::abs(v[1]) + std::abs(v[2]);
+            if (l1 == 0) return {0, 0};
+            double u = v[0] / l1, w = v[1] / l1;
+            if (v[2] < 0) {
+                double fu = (1.0 - std::abs(w)) * (u >= 0 ? 1.0 : -1.0);
+                double fw = (1.0 - std::abs(u)) * (w >= 0 ? 1.0 : -1.0);
+                u = fu;
+                w = fw;
+            }
+            return {(int16_t) std::lround(std::clamp(u, -1.0, 1.0) * 32767.0),
+                    (int16_t) std::lround(std::clamp(w, -1.0, 1.0) * 32767.0)};
+        }
+
+        // Decodes into a unit vector
+        Vec3 decode() const {
+            double u = x / 32767.0, w = y / 32767.0;
+            double z = 1.0 - std::abs(u) - std::abs(w);
+            if (z < 0) {
+                double fu = (1.0 - std::abs(w)) * (u >= 0 ? 1.0 : -1.0);
+                double fw = (1.0 - std::abs(u)) * (w >= 0 ? 1.0 : -1.0);
+                u = fu;
+                w = fw;
+            }
+            return Vec3{u, w, z}.normalised();
+        }
+    };
+
+    // The bounds of a block of quantised positions. Each axis is mapped linearly from [0, 65535] onto
+    // [origin, origin + extent], so positions are within extent / 131070 of the original on each axis,
+    // plus the error from storing the bounds as floats.
+    struct PositionBlock {
+        Vec3f origin;
+        Vec3f extent;
+    };
+
+    // Encodes quaternions into packed quaternions, splitting the work across threads.
+    // Throws std::invalid_argument if the arrays differ in length.
+    template<typename P>
+    void encode_quaternions(std::span<const Quaternion> quaternions, std::span<P> packed) {
+        if (quaternions.size() != packed.size())
+            throw std::invalid_argument("Cannot encode quaternions into an array of a different length");
+        parallel_for(quaternions.size(), [&](size_t begin, size_t end) {
+            for (size_t n = begin; n < end; n++) packed[n] = P::encode(quaternions[n]);
+        });
+    }
+
+    // Decodes packed quaternions, splitting the work across threads.
+    // Throws std::invalid_argument if the arrays differ in length.
+    template<typename P>
+    void decode_quaternions(std::span<const P> packed, std::span<Quaternion> quaternions) {
+        if (quaternions.size() != packed.size())
+            throw std::invalid_argument("Cannot decode quaternions into an array of a different length");
+        parallel_for(packed.size(), [&](size_t begin, size_t end) {
+            for (size_t n = begin; n < end; n++) quaternions[n] = packed[n].decode();
+        });
+    }
+
+    // Encodes unit directions, splitting the work across threads.
+    // Throws std::invalid_argument if the arrays differ in length.
+    inline void encode_directions(std::span<const Vec3> directions, std::span<PackedDirection> packed) {
+        if (directions.size() != packed.size())
+            throw std::invalid_argument("Cannot encode directions into an array of a different length");
+        parallel_for(directions.size(), [&](size_t begin, size_t end) {
+            for (size_t n = begin; n < end; n++) packed[n] = PackedDirection::encode(directions[n]);
+        });
+    }
+
+    // Decodes unit directions, splitting the work across threads.
+    // Throws std::invalid_argument if the arrays differ in length.
+    inline void decode_directions(std::span<const PackedDirection> packed, std::span<Vec3> directions) {
+        if (directions.size() != packed.size())
+            throw std::invalid_argument("Cannot decode directions into an array of a different length");
+        parallel_for(packed.size(), [&](size_t begin, size_t end) {
+            for (size_t n = begin; n < end; n++) directions[n] = packed[n].decode();
+        });
+    }
+
+    // Returns the number of blocks needed to quantise count positions
+    inline size_t position_block_count(size_t count, size_t block_size) {
+        return (count + block_size - 1) / block_size;
+    }
+
+    // Quantises positions to 16 bits per axis relative to the bounds of each block of block_size positions.
+    // Throws std::invalid_argument if the output arrays are the wrong length.
+    inline void encode_positions(std::span<const Vec3> positions, std::span<Vector<3, uint16_t>> quantised,
+                                 std::span<PositionBlock> blocks, size_t block_size = 256) {
+        if (block_size == 0 || quantised.size() != positions.size() ||
+            blocks.size() != position_block_count(positions.size(), block_size))
+            throw std::invalid_argument("Quantised position arrays are the wrong length");
+
+        parallel_for(blocks.size(), [&](size_t first_block, size_t last_block) {
+            for (size_t b = first_block; b < last_block; b++) {
+                size_t begin = b * block_size, end = std::min(positions.size(), begin + block_size);
+
+                Vec3 low = positions[begin], high = positions[begin];
+                for (size_t n = begin; n < end; n++) {
+                    for (int a = 0; a < 3; a++) {
+                        low[a] = std::min(low[a], positions[n][a]);
+                        high[a] = std::max(high[a], positions[n][a]);
+                    }
+                }
+
+                PositionBlock &block = blocks[b];
+                double inverse_extent[3];
+                for (int a = 0; a < 3; a++) {
+                    block.origin[a] = (float) low[a];
+                    block.extent[a] = (float) (high[a] - low[a]);
+                    inverse_extent[a] = block.extent[a] > 0 ? 65535.0 / block.extent[a] : 0.0;
+                }
+
+                for (size_t n = begin; n < end; n++)
+                    for (int a = 0; a < 3; a++)
+                        quantised[n][a] = (uint16_t) std::lround(std::clamp(
+                                (positions[n][a] - block.origin[a]) * inverse_extent[a], 0.0, 65535.0));
+            }
+        }, 1);
+    }
+
+    // Inverse of encode_positions.
+    // Throws std::invalid_argument if the output arrays are the wrong length.
+    inline void decode_positions(std::span<const Vector<3, uint16_t>> quantised, std::span<const PositionBlock> blocks,
+                                 std::span<Vec3> positions, size_t block_size = 256) {
+        if (block_size == 0 || quantised.size() != positions.size() ||
+            blocks.size() != position_block_count(positions.size(), block_size))
+            throw std::invalid_argument("Quantised position arrays are the wrong length");
+
+        parallel_for(positions.size(), [&](size_t begin, size_t end) {
+            for (size_t n = begin; n < end; n++) {
+                const PositionBlock &block = blocks[n / block_size];
+                for (int a = 0; a < 3; a++)
+                    positions[n][a] = block.origin[a] + quantised[n][a] * (block.extent[a] / 65535.0);
+            }
+        });
+    }
+}
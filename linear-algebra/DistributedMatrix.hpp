@@ -0,0 +1,284 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "Scalar.hpp"
+#include "Backend.hpp"
+#include "DynamicMatrix.hpp"
+#include "Processes.hpp"
+
+namespace LinearAlgebra {
+    // Memory shared between a process and the workers it forks, backed by a POSIX shared memory object. The object
+    // is unlinked as soon as it is mapped, so nothing is left in /dev/shm if the process dies. Pages are allocated
+    // when first written, on the NUMA node of the process that writes them.
+    class SharedSegment {
+    private:
+        void *address = nullptr;
+        size_t length = 0;
+
+    public:
+        // Creates an empty segment
+        SharedSegment() = default;
+
+        // Creates a zero filled segment of the given size.
+        // Throws std::runtime_error if the shared memory object cannot be created or mapped.
+        explicit SharedSegment(size_t bytes) : length(bytes) {
+            if (bytes == 0) return;
+
+            static std::atomic<unsigned int> counter{0};
+            std::string name = "/linear-algebra-" + std::to_string(getpid()) + "-" + std::to_string(counter++);
+            int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+            if (fd < 0)
+                throw std::runtime_error("Failed to create shared memory segment: " + name);
+            shm_unlink(name.c_str());
+
+            if (ftruncate(fd, (off_t) bytes) != 0) {
+                close(fd);
+                throw std::runtime_error("Failed to size shared memory segment: " + name);
+            }
+            void *mapped = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            close(fd);
+            if (mapped == MAP_FAILED)
+                throw std::runtime_error("Failed to map shared memory segment: " + name);
+            address = mapped;
+        }
+
+        SharedSegment(const SharedSegment &) = delete;
+
+        SharedSegment &operator=(const SharedSegment &) = delete;
+
+        // Move constructor. Leaves the other segment empty.
+        SharedSegment(SharedSegment &&other) noexcept: address(other.address), length(other.length) {
+            other.address = nullptr;
+            other.length = 0;
+        }
+
+        // Move assignment. Leaves the other segment empty.
+        SharedSegment &operator=(SharedSegment &&other) noexcept {
+            std::swap(address, other.address);
+            std::swap(length, other.length);
+            return *this;
+        }
+
+        ~SharedSegment() {
+            if (address) munmap(address, length);
+        }
+
+        // Returns the start of the segment
+        void *data() const {
+            return address;
+        }
+
+        // Returns the size of the segment in bytes
+        size_t size() const {
+            return length;
+        }
+    };
+
+    // A grid of worker processes. The process in grid row r and column c is worker r * columns + c.
+    struct ProcessGrid {
+        unsigned int rows = 1, columns = 1;
+
+        // Returns the number of workers in the grid
+        unsigned int size() const {
+            return rows * columns;
+        }
+
+        // Tests if 2 grids are the same shape
+        bool operator==(const ProcessGrid &b) const {
+            return rows == b.rows && columns == b.columns;
+        }
+    };
+
+    // Matrix split into square blocks which are dealt out block-cyclically over a grid of worker processes: block
+    // (I, J) belongs to the worker in grid row I mod rows and grid column J mod columns. Each worker's blocks are
+    // stored together, row by row, as one local matrix in a shared memory segment, so the workers of one machine
+    // can all read each other's blocks. Workers write only their own segment, which is first touched by the
+    // worker after it is pinned to its NUMA node, placing each local matrix in the memory of the node using it.
+    // Operations which fork workers must be called while no other thread is running, as with fork_workers.
+    template<typename T = double> requires Scalar<T>
+    class DistributedMatrix {
+    private:
+        unsigned int height, width, block;
+        ProcessGrid process_grid;
+        std::vector<SharedSegment> segments;
+
+        // Returns how many of extent rows or columns are held by index out of count processes
+        static unsigned int local_extent(unsigned int extent, unsigned int block, unsigned int count,
+                                         unsigned int index) {
+            unsigned int blocks = extent / block, extra = blocks % count;
+            unsigned int local = blocks / count * block;
+            if (index < extra) local += block;
+            else if (index == extra) local += extent % block;
+            return local;
+        }
+
+        // Returns the global index of a local row or column of the process at index out of count
+        static unsigned int global_index(unsigned int local, unsigned int block, unsigned int count,
+                                         unsigned int index) {
+            return (local / block * count + index) * block + local % block;
+        }
+
+        // Returns the index of global row i and column j in the local matrix of the worker which owns it
+        size_t local_index(unsigned int i, unsigned int j) const {
+            unsigned int row = i / block / process_grid.rows * block + i % block;
+            unsigned int column = j / block / process_grid.columns * block + j % block;
+            return (size_t) row * (*this).local_columns((*this).owner(i, j)) + column;
+        }
+
+    public:
+        // Creates a zero rows x columns matrix in blocks of block_size over the process grid.
+        // Throws std::invalid_argument if the block size or grid is empty.
+        DistributedMatrix(unsigned int rows, unsigned int columns, unsigned int block_size, ProcessGrid grid)
+                : height(rows), width(columns), block(block_size), process_grid(grid) {
+            if (block_size == 0 || grid.size() == 0)
+                throw std::invalid_argument("Distributed matrices need a non-zero block size and process grid");
+            for (unsigned int worker = 0; worker < grid.size(); worker++)
+                segments.emplace_back(sizeof(T) * (*this).local_rows(worker) * (*this).local_columns(worker));
+        }
+
+        // Distributes a matrix over the process grid. Each worker copies its own blocks, so that they are placed on
+        // its NUMA node. Throws std::runtime_error if a worker fails.
+        static DistributedMatrix scatter(const DynamicMatrix<T> &m, unsigned int block_size, ProcessGrid grid,
+                                         const NumaTopology &topology = NumaTopology::detect()) {
+            DistributedMatrix distributed(m.rows(), m.columns(), block_size, grid);
+            fork_workers(grid.size(), topology, [&](unsigned int worker) {
+                unsigned int rows = distributed.local_rows(worker), columns = distributed.local_columns(worker);
+                unsigned int r = worker / grid.columns, c = worker % grid.columns;
+                T *local = distributed.local_data(worker);
+                for (unsigned int i = 0; i < rows; i++) {
+                    unsigned int row = global_index(i, block_size, grid.rows, r);
+                    for (unsigned int j = 0; j < columns; j++)
+                        local[(size_t) i * columns + j] = m(row, global_index(j, block_size, grid.columns, c));
+                }
+            });
+            return distributed;
+        }
+
+        // Collects the blocks of every worker into a single matrix
+        DynamicMatrix<T> gather() const {
+            DynamicMatrix<T> m(height, width);
+            for (unsigned int worker = 0; worker < process_grid.size(); worker++) {
+                unsigned int rows = (*this).local_rows(worker), columns = (*this).local_columns(worker);
+                unsigned int r = worker / process_grid.columns, c = worker % process_grid.columns;
+                const T *local = (*this).local_data(worker);
+                for (unsigned int i = 0; i < rows; i++) {
+                    unsigned int row = global_index(i, block, process_grid.rows, r);
+                    for (unsigned int j = 0; j < columns; j++)
+                        m(row, global_index(j, block, process_grid.columns, c)) = local[(size_t) i * columns + j];
+                }
+            }
+            return m;
+        }
+
+        // Returns the number of rows
+        unsigned int rows() const {
+            return height;
+        }
+
+        // Returns the number of columns
+        unsigned int columns() const {
+            return width;
+        }
+
+        // Returns the side length of the blocks
+        unsigned int block_size() const {
+            return block;
+        }
+
+        // Returns the grid of worker processes the blocks are dealt over
+        ProcessGrid grid() const {
+            return process_grid;
+        }
+
+        // Returns the worker holding global row i and column j
+        unsigned int owner(unsigned int i, unsigned int j) const {
+            return i / block % process_grid.rows * process_grid.columns + j / block % process_grid.columns;
+        }
+
+        // Returns the number of rows in the local matrix of a worker
+        unsigned int local_rows(unsigned int worker) const {
+            return local_extent(height, block, process_grid.rows, worker / process_grid.columns);
+        }
+
+        // Returns the number of columns in the local matrix of a worker
+        unsigned int local_columns(unsigned int worker) const {
+            return local_extent(width, block, process_grid.columns, worker % process_grid.columns);
+        }
+
+        // Returns the local matrix of a worker, stored row by row
+        T *local_data(unsigned int worker) {
+            return static_cast<T *>(segments[worker].data());
+        }
+
+        // Returns the local matrix of a worker, stored row by row
+        const T *local_data(unsigned int worker) const {
+            return static_cast<const T *>(segments[worker].data());
+        }
+
+        // Mutable accessor. Writing through it from the creating process places pages on that process's node.
+        T &operator()(unsigned int i, unsigned int j) {
+            return (*this).local_data((*this).owner(i, j))[(*this).local_index(i, j)];
+        }
+
+        // Immutable accessor
+        const T &operator()(unsigned int i, unsigned int j) const {
+            return (*this).local_data((*this).owner(i, j))[(*this).local_index(i, j)];
+        }
+
+        // Multiplies 2 distributed matrices with the SUMMA algorithm, with one forked worker per grid position.
+        // At each step along the inner dimension, every worker copies the column panel of this matrix from the
+        // worker in its grid row which holds it, and the row panel of b from the worker in its grid column which
+        // holds it, into its own memory, then adds their product to its local blocks of the result.
+        // Throws std::invalid_argument if the matrices have mismatched dimensions, blocks or grids, and
+        // std::runtime_error if a worker fails.
+        DistributedMatrix multiply_matrix(const DistributedMatrix &b,
+                                          const NumaTopology &topology = NumaTopology::detect()) const {
+            if (width != b.height)
+                throw std::invalid_argument("Cannot multiply matrices with mismatched dimensions");
+            if (block != b.block || !(process_grid == b.process_grid))
+                throw std::invalid_argument("Cannot multiply matrices distributed over different blocks or grids");
+
+            DistributedMatrix product(height, b.width, block, process_grid);
+            fork_workers(process_grid.size(), topology, [&](unsigned int worker) {
+                unsigned int r = worker / process_grid.columns, c = worker % process_grid.columns;
+                unsigned int rows = product.local_rows(worker), columns = product.local_columns(worker);
+                T *local = product.local_data(worker);
+                std::fill(local, local + (size_t) rows * columns, T(0));
+
+                std::vector<T> a_panel((size_t) rows * block), b_panel((size_t) block * columns);
+                std::vector<T> step((size_t) rows * columns);
+                for (unsigned int k = 0; k * block < width; k++) {
+                    unsigned int depth = std::min(block, width - k * block);
+
+                    unsigned int a_owner = r * process_grid.columns + k % process_grid.columns;
+                    unsigned int a_columns = (*this).local_columns(a_owner);
+                    const T *a_local = (*this).local_data(a_owner) + k / process_grid.columns * block;
+                    for (unsigned int i = 0; i < rows; i++)
+                        std::copy_n(a_local + (size_t) i * a_columns, depth, a_panel.data() + (size_t) i * depth);
+
+                    unsigned int b_owner = k % process_grid.rows * process_grid.columns + c;
+                    unsigned int b_offset = k / process_grid.rows * block;
+                    const T *b_local = b.local_data(b_owner);
+                    std::copy_n(b_local + (size_t) b_offset * columns, (size_t) depth * columns, b_panel.data());
+
+                    Backend::gemm(select_backend<T>((size_t) rows * depth * columns), rows, depth, columns,
+                                  a_panel.data(), b_panel.data(), step.data());
+                    for (size_t n = 0; n < step.size(); n++) local[n] += step[n];
+                }
+            });
+            return product;
+        }
+
+        // Operator overload for matrix multiplication
+        DistributedMatrix operator*(const DistributedMatrix &b) const {
+            return (*this).multiply_matrix(b);
+        }
+    };
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cmath>
+#include "Vector.hpp"
+#include "Matrix.hpp"
+#include "Orientation.hpp"
+
+namespace LinearAlgebra {
+    // Structure representing a dual quaternion real + ε dual.
+    // Unit dual quaternions represent rigid transforms: a rotation followed by a translation.
+    struct DualQuaternion {
+        // The real and dual parts respectively
+        Quaternion real, dual;
+
+        // Default identity constructor
+        DualQuaternion() : real(1.0), dual() {}
+
+        // Explicitly initialise both parts
+        DualQuaternion(const Quaternion &real, const Quaternion &dual) : real(real), dual(dual) {}
+
+        // Construct the rigid transform which rotates by a unit quaternion and then translates
+        static DualQuaternion rigid(const Quaternion &rotation, const Vec3 &translation) {
+            return {rotation, Quaternion::multiply(0.5, Quaternion(translation) * rotation)};
+        }
+
+        // Construct the rigid transform described by the upper 3x4 part of a homogeneous matrix.
+        // The upper-left 3x3 block is assumed to be a rotation.
+        static DualQuaternion from_matrix(const Mat4 &m) {
+            Mat3 rotation([&m](unsigned int i, unsigned int j) { return m[i][j]; });
+            return rigid(Quaternion::from_matrix(rotation), Vec3{m[0][3], m[1][3], m[2][3]});
+        }
+
+        // Returns the rotation part of a unit dual quaternion
+        Quaternion rotation() const {
+            return real;
+        }
+
+        // Returns the translation part of a unit dual quaternion
+        Vec3 translation() const {
+            return Quaternion::multiply(2.0, dual * real.conjugate()).vector_part();
+        }
+
+        // Defines dual quaternion addition
+        static DualQuaternion plus(const DualQuaternion &a, const DualQuaternion &b) {
+            return {a.real + b.real, a.dual + b.dual};
+        }
+
+        // Operator overload for dual quaternion addition
+        DualQuaternion operator+(const DualQuaternion &b) const {
+            return plus(*this, b);
+        }
+
+        // Defines dual quaternion multiplication by a scalar constant
+        static DualQuaternion multiply(double a, const DualQuaternion &b) {
+            return {Quaternion::multiply(a, b.real), Quaternion::multiply(a, b.dual)};
+        }
+
+        // Defines dual quaternion multiplication. The result applies b and then a.
+        static DualQuaternion multiply(const DualQuaternion &a, const DualQuaternion &b) {
+            return {a.real * b.real, a.real * b.dual + a.dual * b.real};
+        }
+
+        // Operator overload for dual quaternion multiplication
+        DualQuaternion operator*(const DualQuaternion &b) const {
+            return multiply(*this, b);
+        }
+
+        // Returns the quaternion conjugate of both parts. This is the inverse of a unit dual quaternion.
+        DualQuaternion conjugate() const {
+            return {real.conjugate(), dual.conjugate()};
+        }
+
+        // Returns the closest unit dual quaternion.
+        // Scales by the magnitude of the real part and removes the component of the dual part along the real part.
+        DualQuaternion normalised() const {
+            double scale = 1.0 / real.magnitude();
+            Quaternion unit_real = Quaternion::multiply(scale, real);
+            Quaternion unit_dual = Quaternion::multiply(scale, dual);
+            unit_dual -= Quaternion::multiply(Quaternion::dot_product(unit_real, unit_dual), unit_real);
+            return {unit_real, unit_dual};
+        }
+
+        // Normalises the dual quaternion
+        void normalise() {
+            (*this) = normalised();
+        }
+
+        // Applies the rigid transform to a point
+        Vec3 transform_point(const Vec3 &point) const {
+            return transform_vector(point) + translation();
+        }
+
+        // Applies only the rotation to a direction
+        Vec3 transform_vector(const Vec3 &vector) const {
+            Vec3 axis = real.vector_part();
+            Vec3 t = axis.cross_product(vector) * 2.0;
+            return vector + t * real.r + axis.cross_product(t);
+        }
+
+        // Returns the rigid transform as a homogeneous matrix
+        Mat4 as_matrix() const {
+            Mat4 m(real.as_matrix());
+            Vec3 offset = translation();
+            for (int i = 0; i < 3; i++) m[i][3] = offset[i];
+            return m;
+        }
+    };
+}
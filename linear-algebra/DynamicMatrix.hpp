@@ -0,0 +1,226 @@
+#pragma once
+
+#include <cmath>
+#include <memory_resource>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "Scalar.hpp"
+#include "Backend.hpp"
+#include "Matrix.hpp"
+#include "Workspace.hpp"
+
+namespace LinearAlgebra {
+    // Matrix whose size is chosen at runtime. Values are stored row by row on the heap, taken from the memory
+    // resource of the current Workspace when the matrix is created.
+    template<typename T = double> requires Scalar<T>
+    class DynamicMatrix {
+    private:
+        unsigned int height = 0, width = 0;
+        std::pmr::vector<T> values;
+
+        // Throws std::invalid_argument if b is not the same size
+        void check_same_size(const DynamicMatrix &b) const {
+            if (height != b.height || width != b.width)
+                throw std::invalid_argument("Matrices must be the same size");
+        }
+
+    public:
+        // Creates an empty matrix
+        DynamicMatrix() : values(Workspace::resource()) {}
+
+        // Creates a height x width matrix. Square matrices are the identity, others are zero.
+        DynamicMatrix(unsigned int height, unsigned int width)
+                : height(height), width(width), values((size_t) height * width, T(0), Workspace::resource()) {
+            if (height == width) for (unsigned int i = 0; i < height; i++) (*this)(i, i) = 1;
+        }
+
+        // Creates a matrix with the same values as a fixed size matrix
+        template<unsigned int H, unsigned int W>
+        explicit DynamicMatrix(const Matrix<H, W, T> &m) : DynamicMatrix(H, W) {
+            for (unsigned int i = 0; i < H; i++) for (unsigned int j = 0; j < W; j++) (*this)(i, j) = m[i][j];
+        }
+
+        // Copies into storage from the current workspace, not the workspace of the original
+        DynamicMatrix(const DynamicMatrix &b)
+                : height(b.height), width(b.width), values(b.values, Workspace::resource()) {}
+
+        // Moves the storage of the original, which keeps the memory resource it was created with
+        DynamicMatrix(DynamicMatrix &&b) noexcept = default;
+
+        // Copy assignment. Reuses the existing storage where possible.
+        DynamicMatrix &operator=(const DynamicMatrix &b) {
+            height = b.height;
+            width = b.width;
+            values.assign(b.values.begin(), b.values.end());
+            return *this;
+        }
+
+        // Move assignment. Copies instead if the two matrices use different memory resources.
+        DynamicMatrix &operator=(DynamicMatrix &&b) = default;
+
+        // Returns the number of rows
+        unsigned int rows() const {
+            return height;
+        }
+
+        // Returns the number of columns
+        unsigned int columns() const {
+            return width;
+        }
+
+        // Mutable accessor
+        T &operator()(unsigned int i, unsigned int j) {
+            return values[(size_t) i * width + j];
+        }
+
+        // Immutable accessor
+        const T &operator()(unsigned int i, unsigned int j) const {
+            return values[(size_t) i * width + j];
+        }
+
+        // Returns raw pointer to internal data
+        T *data() {
+            return values.data();
+        }
+
+        // Returns const raw pointer to internal data
+        const T *data() const {
+            return values.data();
+        }
+
+        // Returns the memory resource the values are stored in
+        std::pmr::memory_resource *resource() const {
+            return values.get_allocator().resource();
+        }
+
+        // Tests is 2 matrices are equal
+        bool equals(const DynamicMatrix &b) const {
+            return height == b.height && width == b.width && values == b.values;
+        }
+
+        // Operator overload for matrix equality
+        bool operator==(const DynamicMatrix &b) const {
+            return (*this).equals(b);
+        }
+
+        // Returns the piecewise sum result of 2 matrices.
+        // Throws std::invalid_argument if the matrices are different sizes.
+        DynamicMatrix plus(const DynamicMatrix &b) const {
+            check_same_size(b);
+            DynamicMatrix sum(height, width);
+            for (size_t n = 0; n < values.size(); n++) sum.values[n] = values[n] + b.values[n];
+            return sum;
+        }
+
+        // Operator Overload for matrices addition
+        DynamicMatrix operator+(const DynamicMatrix &b) const {
+            return (*this).plus(b);
+        }
+
+        // Returns the piecewise difference of 2 matrices.
+        // Throws std::invalid_argument if the matrices are different sizes.
+        DynamicMatrix minus(const DynamicMatrix &b) const {
+            check_same_size(b);
+            DynamicMatrix difference(height, width);
+            for (size_t n = 0; n < values.size(); n++) difference.values[n] = values[n] - b.values[n];
+            return difference;
+        }
+
+        // Operator overload for matrix subtraction
+        DynamicMatrix operator-(const DynamicMatrix &b) const {
+            return (*this).minus(b);
+        }
+
+        // Scales r matrix by r given constant
+        DynamicMatrix scale(T m) const {
+            DynamicMatrix scaled(height, width);
+            for (size_t n = 0; n < values.size(); n++) scaled.values[n] = m * values[n];
+            return scaled;
+        }
+
+        // Operator overload for constant multiplication
+        DynamicMatrix operator*(const T &b) const {
+            return (*this).scale(b);
+        }
+
+        // Multiplies 2 matrices together. Products of a matrix with a single column are matrix-vector products.
+        // Large products of float or double matrices are run by BLAS when available, otherwise accumulates in
+        // accumulator_t<T>. Throws std::invalid_argument if the inner dimensions differ.
+        DynamicMatrix multiply_matrix(const DynamicMatrix &b) const {
+            if (width != b.height)
+                throw std::invalid_argument("Cannot multiply matrices with mismatched dimensions");
+
+            DynamicMatrix multiply(height, b.width);
+            if (b.width == 1)
+                Backend::gemv(select_backend<T>((size_t) height * width), height, width, data(), b.data(),
+                              multiply.data());
+            else
+                Backend::gemm(select_backend<T>((size_t) height * width * b.width), height, width, b.width, data(),
+                              b.data(), multiply.data());
+            return multiply;
+        }
+
+        // Operator overload for matrix multiplication
+        DynamicMatrix operator*(const DynamicMatrix &b) const {
+            return (*this).multiply_matrix(b);
+        }
+
+        // Transposes the matrix
+        DynamicMatrix transpose() const {
+            DynamicMatrix transpose(width, height);
+            for (unsigned int i = 0; i < height; i++)
+                for (unsigned int j = 0; j < width; j++) transpose(j, i) = (*this)(i, j);
+            return transpose;
+        }
+
+        // Solves AX = B for X by LU decomposition with partial pivoting, run by BLAS for large systems when available.
+        // Throws std::invalid_argument if the matrix is singular or the sizes are mismatched.
+        DynamicMatrix solve(const DynamicMatrix &b) const {
+            if (height != width || b.height != height)
+                throw std::invalid_argument("Cannot solve a non-square or mismatched system");
+
+            DynamicMatrix a(*this), x(b);
+            Backend::lu_solve(select_backend<T>((size_t) width * width * width), width, a.data(), x.width, x.data());
+            return x;
+        }
+
+        // Calculates the inverse of the matrix.
+        // Throws std::invalid_argument if the matrix is singular or not square.
+        DynamicMatrix inverse() const {
+            return (*this).solve(DynamicMatrix(height, height));
+        }
+
+        // Returns the lower triangular L such that LLᵀ is the matrix, run by BLAS for large matrices when available.
+        // Only the lower triangle is read. Throws std::invalid_argument if the matrix is not positive definite.
+        DynamicMatrix cholesky() const {
+            if (height != width)
+                throw std::invalid_argument("Cannot take the Cholesky decomposition of a non-square matrix");
+
+            DynamicMatrix l(*this);
+            Backend::cholesky(select_backend<T>((size_t) width * width * width), width, l.data());
+            return l;
+        }
+
+        // Returns Q with orthonormal columns and upper triangular R with a non-negative diagonal such that QR is the
+        // matrix, run by BLAS for large matrices when available.
+        // Throws std::invalid_argument if the matrix has more columns than rows.
+        std::tuple<DynamicMatrix, DynamicMatrix> qr() const {
+            DynamicMatrix q(height, width), r(width, width);
+            Backend::qr(select_backend<T>((size_t) height * width * width), height, width, data(), q.data(),
+                        r.data());
+            return std::make_tuple(std::move(q), std::move(r));
+        }
+    };
+
+    // Overloads operator to make scalar multiplication commutative
+    template<typename T>
+    DynamicMatrix<T> operator*(const T scalar, const DynamicMatrix<T> &matrix) {
+        return matrix * scalar;
+    }
+
+    // Aliases for common types
+    using MatX = DynamicMatrix<double>;
+    using MatXf = DynamicMatrix<float>;
+}
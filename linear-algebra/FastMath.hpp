@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cmath>
+#include <limits>
+
+#if defined(__SSE__)
+#include <xmmintrin.h>
+#endif
+
+namespace LinearAlgebra {
+    // Approximates 1 / sqrt(x) for positive x using the hardware reciprocal square root estimate
+    // refined with one Newton-Raphson step. The relative error is below 5e-7.
+    // The result for 0 is not meaningful. Falls back to 1 / sqrt(x) for denormal x, which the estimate flushes to
+    // zero, and on targets without a hardware estimate.
+    inline float reciprocal_sqrt(float x) {
+#if defined(__SSE__)
+        if (x < std::numeric_limits<float>::min()) return 1.0f / std::sqrt(x);
+        float estimate = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x)));
+        return estimate * (1.5f - 0.5f * x * estimate * estimate);
+#else
+        return 1.0f / std::sqrt(x);
+#endif
+    }
+
+    // Approximates 1 / sqrt(x) for positive x by refining the float approximation with a second Newton-Raphson step
+    // in double precision. The relative error is below 5e-13. The estimate is made in single precision, so x outside
+    // the normal range of float falls back to 1 / sqrt(x).
+    inline double reciprocal_sqrt(double x) {
+#if defined(__SSE__)
+        if (x < std::numeric_limits<float>::min() || x > std::numeric_limits<float>::max()) return 1.0 / std::sqrt(x);
+        double estimate = reciprocal_sqrt((float) x);
+        return estimate * (1.5 - 0.5 * x * estimate * estimate);
+#else
+        return 1.0 / std::sqrt(x);
+#endif
+    }
+}
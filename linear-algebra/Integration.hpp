@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cmath>
+#include <span>
+#include <stdexcept>
+#include "Vector.hpp"
+#include "Matrix.hpp"
+#include "Orientation.hpp"
+#include "Parallel.hpp"
+
+namespace LinearAlgebra {
+    // How angular velocity is integrated into an orientation
+    enum class IntegrationMethod {
+        // q += dt / 2 * ω q, then renormalised. Cheap, but loses accuracy at high angular speeds.
+        FirstOrder,
+        // q = exp(dt / 2 * ω) q. Exact for constant angular velocity over the step.
+        ExponentialMap
+    };
+
+    // Orientations stored as separate arrays of each quaternion component
+    struct QuaternionArrays {
+        std::span<double> r, i, j, k;
+    };
+
+    // World space angular velocities stored as separate arrays of each component, in radians per unit time
+    struct AngularVelocityArrays {
+        std::span<const double> x, y, z;
+    };
+
+    namespace Detail {
+        // Integrates one orientation in place and returns it normalised. Shared by the single and batch forms so
+        // they give identical results.
+        inline void integrate_orientation(double &r, double &i, double &j, double &k, double wx, double wy, double wz,
+                                          double dt, IntegrationMethod method) {
+            // The rotation to apply, as a quaternion (a, b, c, d), before normalisation
+            double a, b, c, d;
+            double hx = 0.5 * dt * wx, hy = 0.5 * dt * wy, hz = 0.5 * dt * wz;
+            if (method == IntegrationMethod::FirstOrder) {
+                a = 1;
+                b = hx, c = hy, d = hz;
+            } else {
+                double angle_squared = hx * hx + hy * hy + hz * hz;
+                double angle = std::sqrt(angle_squared);
+                // sin(x) / x, using its Taylor series near 0 to avoid dividing by 0
+                double sinc = angle > 1e-4 ? std::sin(angle) / angle : 1 - angle_squared / 6;
+                a = std::cos(angle);
+                b = sinc * hx, c = sinc * hy, d = sinc * hz;
+            }
+
+            double nr = a * r - b * i - c * j - d * k;
+            double ni = a * i + b * r + c * k - d * j;
+            double nj = a * j - b * k + c * r + d * i;
+            double nk = a * k + b * j - c * i + d * r;
+            double inverse = 1 / std::sqrt(nr * nr + ni * ni + nj * nj + nk * nk);
+            r = nr * inverse, i = ni * inverse, j = nj * inverse, k = nk * inverse;
+        }
+    }
+
+    // Returns the orientation q after rotating at world space angular velocity ω for time dt
+    inline Quaternion integrate_orientation(const Quaternion &q, const Vec3 &angular_velocity, double dt,
+                                            IntegrationMethod method = IntegrationMethod::ExponentialMap) {
+        Quaternion result = q;
+        Detail::integrate_orientation(result.r, result.i, result.j, result.k,
+                                      angular_velocity[0], angular_velocity[1], angular_velocity[2], dt, method);
+        return result;
+    }
+
+    // Integrates every orientation in place over time dt, splitting the work across threads.
+    // If rotations is not empty the rotation matrix of each updated orientation is written to it in the same pass.
+    // Throws std::invalid_argument if the arrays differ in length.
+    inline void integrate_orientations(const QuaternionArrays &orientations,
+                                       const AngularVelocityArrays &angular_velocities, double dt,
+                                       IntegrationMethod method = IntegrationMethod::ExponentialMap,
+                                       std::span<Mat3> rotations = {}) {
+        size_t count = orientations.r.size();
+        if (orientations.i.size() != count || orientations.j.size() != count || orientations.k.size() != count ||
+            angular_velocities.x.size() != count || angular_velocities.y.size() != count ||
+            angular_velocities.z.size() != count || (!rotations.empty() && rotations.size() != count))
+            throw std::invalid_argument("Orientation and angular velocity arrays must all have the same length");
+
+        parallel_for(count, [&](size_t begin, size_t end) {
+            for (size_t n = begin; n < end; n++) {
+                double &r = orientations.r[n], &i = orientations.i[n], &j = orientations.j[n], &k = orientations.k[n];
+                Detail::integrate_orientation(r, i, j, k, angular_velocities.x[n], angular_velocities.y[n],
+                                              angular_velocities.z[n], dt, method);
+                if (!rotations.empty()) {
+                    Mat3 &m = rotations[n];
+                    m[0][0] = 1 - 2 * (j * j + k * k), m[0][1] = 2 * (i * j - k * r), m[0][2] = 2 * (i * k + j * r);
+                    m[1][0] = 2 * (i * j + k * r), m[1][1] = 1 - 2 * (i * i + k * k), m[1][2] = 2 * (j * k - i * r);
+                    m[2][0] = 2 * (i * k - j * r), m[2][1] = 2 * (j * k + i * r), m[2][2] = 1 - 2 * (i * i + j * j);
+                }
+            }
+        });
+    }
+}
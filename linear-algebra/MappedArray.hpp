@@ -0,0 +1,270 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "Vector.hpp"
+#include "Matrix.hpp"
+#include "Orientation.hpp"
+
+namespace LinearAlgebra {
+    // The kind of object stored in a mapped array file
+    enum class ElementKind : uint32_t {
+        Vector = 1,
+        Matrix = 2,
+        Quaternion = 3
+    };
+
+    // The scalar type each element is built from
+    enum class ScalarKind : uint32_t {
+        Int8 = 1, UInt8, Int16, UInt16, Int32, UInt32, Int64, UInt64, Float32, Float64
+    };
+
+    // Maps a scalar type onto its tag in the file format
+    template<typename T>
+    constexpr ScalarKind scalar_kind() {
+        if constexpr (std::is_floating_point<T>::value) {
+            static_assert(sizeof(T) == 4 || sizeof(T) == 8, "Unsupported floating point width");
+            return sizeof(T) == 4 ? ScalarKind::Float32 : ScalarKind::Float64;
+        } else {
+            static_assert(std::is_integral<T>::value, "Unsupported scalar type");
+            constexpr bool is_signed = std::is_signed<T>::value;
+            if constexpr (sizeof(T) == 1) return is_signed ? ScalarKind::Int8 : ScalarKind::UInt8;
+            else if constexpr (sizeof(T) == 2) return is_signed ? ScalarKind::Int16 : ScalarKind::UInt16;
+            else if constexpr (sizeof(T) == 4) return is_signed ? ScalarKind::Int32 : ScalarKind::UInt32;
+            else return is_signed ? ScalarKind::Int64 : ScalarKind::UInt64;
+        }
+    }
+
+    // Describes how an element type is laid out in a mapped array file. Specialised for each storable type.
+    template<typename E>
+    struct ArrayElement;
+
+    template<unsigned int S, typename T>
+    struct ArrayElement<Vector<S, T>> {
+        using Scalar = T;
+        static constexpr ElementKind kind = ElementKind::Vector;
+        static constexpr uint32_t rows = S;
+        static constexpr uint32_t columns = 1;
+    };
+
+    template<unsigned int H, unsigned int W, typename T>
+    struct ArrayElement<Matrix<H, W, T>> {
+        using Scalar = T;
+        static constexpr ElementKind kind = ElementKind::Matrix;
+        static constexpr uint32_t rows = H;
+        static constexpr uint32_t columns = W;
+    };
+
+    template<>
+    struct ArrayElement<Quaternion> {
+        using Scalar = double;
+        static constexpr ElementKind kind = ElementKind::Quaternion;
+        static constexpr uint32_t rows = 4;
+        static constexpr uint32_t columns = 1;
+    };
+
+    // Header at the start of every mapped array file.
+    // Padded to 64 bytes so that the payload which follows it is cache line aligned.
+    struct alignas(64) ArrayFileHeader {
+        // Identifies the file format
+        static constexpr char MAGIC[8] = {'L', 'A', 'A', 'R', 'R', 'A', 'Y', '\0'};
+        // Current version of the format
+        static constexpr uint32_t VERSION = 1;
+        // Written in native byte order. Reads back differently on a machine of the other endianness.
+        static constexpr uint32_t ENDIANNESS_MARKER = 0x01020304;
+
+        char magic[8];
+        uint32_t version;
+        uint32_t endianness;
+        ElementKind kind;
+        uint32_t rows;
+        uint32_t columns;
+        ScalarKind scalar;
+        uint32_t element_size;
+        uint32_t reserved;
+        uint64_t count;
+        uint64_t data_offset;
+    };
+
+    static_assert(sizeof(ArrayFileHeader) == 64, "Mapped array header must be exactly 64 bytes");
+
+    // An array of vectors, matrices or quaternions backed by a memory mapped file.
+    // Elements are used in place, so opening a file costs the same regardless of its size.
+    template<typename E>
+    class MappedArray {
+        static_assert(std::is_trivially_copyable<E>::value, "Mapped elements must be trivially copyable");
+        static_assert(sizeof(E) == ArrayElement<E>::rows * ArrayElement<E>::columns *
+                                   sizeof(typename ArrayElement<E>::Scalar),
+                      "Mapped elements must not contain padding");
+
+    private:
+        // Base address of the mapping
+        void *mapping = nullptr;
+        // Size of the mapping in bytes
+        size_t mapping_size = 0;
+        // Whether the mapping can be written to
+        bool writable = false;
+
+        MappedArray(void *mapping, size_t mapping_size, bool writable)
+                : mapping(mapping), mapping_size(mapping_size), writable(writable) {}
+
+        // Maps the given file descriptor and closes it. The mapping keeps the file alive.
+        static void *map_file(int fd, size_t size, bool writable, const std::string &path) {
+            int protection = writable ? PROT_READ | PROT_WRITE : PROT_READ;
+            void *address = mmap(nullptr, size, protection, MAP_SHARED, fd, 0);
+            close(fd);
+            if (address == MAP_FAILED)
+                throw std::runtime_error("Failed to map array file: " + path);
+            return address;
+        }
+
+        // Returns the header which describes this file for the element type
+        static ArrayFileHeader describe(uint64_t count) {
+            ArrayFileHeader header{};
+            std::memcpy(header.magic, ArrayFileHeader::MAGIC, sizeof(header.magic));
+            header.version = ArrayFileHeader::VERSION;
+            header.endianness = ArrayFileHeader::ENDIANNESS_MARKER;
+            header.kind = ArrayElement<E>::kind;
+            header.rows = ArrayElement<E>::rows;
+            header.columns = ArrayElement<E>::columns;
+            header.scalar = scalar_kind<typename ArrayElement<E>::Scalar>();
+            header.element_size = sizeof(E);
+            header.count = count;
+            header.data_offset = sizeof(ArrayFileHeader);
+            return header;
+        }
+
+    public:
+        // Creates a new file large enough for count elements and maps it for writing.
+        // Throws std::invalid_argument if count elements cannot be addressed, and std::runtime_error if the file
+        // cannot be created.
+        static MappedArray create(const std::string &path, uint64_t count) {
+            if (count > (SIZE_MAX - sizeof(ArrayFileHeader)) / sizeof(E))
+                throw std::invalid_argument("Too many elements for an array file: " + path);
+            ArrayFileHeader header = describe(count);
+            size_t size = header.data_offset + count * sizeof(E);
+
+            int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+            if (fd < 0)
+                throw std::runtime_error("Failed to create array file: " + path);
+            if (ftruncate(fd, (off_t) size) != 0) {
+                close(fd);
+                throw std::runtime_error("Failed to size array file: " + path);
+            }
+
+            MappedArray array(map_file(fd, size, true, path), size, true);
+            std::memcpy(array.mapping, &header, sizeof(header));
+            return array;
+        }
+
+        // Maps an existing file. Elements are writable through the mapping only if writable is true.
+        // Throws std::runtime_error if the file cannot be read or does not hold elements of type E.
+        static MappedArray open(const std::string &path, bool writable = false) {
+            int fd = ::open(path.c_str(), writable ? O_RDWR : O_RDONLY);
+            if (fd < 0)
+                throw std::runtime_error("Failed to open array file: " + path);
+
+            struct stat status{};
+            if (fstat(fd, &status) != 0 || (size_t) status.st_size < sizeof(ArrayFileHeader)) {
+                close(fd);
+                throw std::runtime_error("Array file is truncated: " + path);
+            }
+
+            size_t size = status.st_size;
+            MappedArray array(map_file(fd, size, writable, path), size, writable);
+            const ArrayFileHeader &header = array.header();
+            ArrayFileHeader expected = describe(header.count);
+
+            if (std::memcmp(header.magic, ArrayFileHeader::MAGIC, sizeof(header.magic)) != 0)
+                throw std::runtime_error("Not an array file: " + path);
+            if (header.version != ArrayFileHeader::VERSION)
+                throw std::runtime_error("Unsupported array file version: " + path);
+            if (header.endianness != ArrayFileHeader::ENDIANNESS_MARKER)
+                throw std::runtime_error("Array file was written with a different byte order: " + path);
+            if (header.kind != expected.kind || header.rows != expected.rows ||
+                header.columns != expected.columns || header.scalar != expected.scalar ||
+                header.element_size != expected.element_size)
+                throw std::runtime_error("Array file does not contain the requested element type: " + path);
+            // Compared by division so that a corrupt count cannot overflow past the check
+            if (header.data_offset % alignof(E) != 0 || header.data_offset > size ||
+                header.count > (size - header.data_offset) / sizeof(E))
+                throw std::runtime_error("Array file is truncated: " + path);
+
+            return array;
+        }
+
+        MappedArray(const MappedArray &) = delete;
+
+        MappedArray &operator=(const MappedArray &) = delete;
+
+        // Move constructor. Leaves the other array empty.
+        MappedArray(MappedArray &&other) noexcept
+                : mapping(other.mapping), mapping_size(other.mapping_size), writable(other.writable) {
+            other.mapping = nullptr;
+            other.mapping_size = 0;
+        }
+
+        // Move assignment. Unmaps any file currently held.
+        MappedArray &operator=(MappedArray &&other) noexcept {
+            if (this != &other) {
+                if (mapping) munmap(mapping, mapping_size);
+                mapping = other.mapping;
+                mapping_size = other.mapping_size;
+                writable = other.writable;
+                other.mapping = nullptr;
+                other.mapping_size = 0;
+            }
+            return *this;
+        }
+
+        ~MappedArray() {
+            if (mapping) munmap(mapping, mapping_size);
+        }
+
+        // Returns the header at the start of the file
+        const ArrayFileHeader &header() const {
+            return *static_cast<const ArrayFileHeader *>(mapping);
+        }
+
+        // Returns the number of elements in the file
+        size_t size() const {
+            return header().count;
+        }
+
+        // Returns the elements for writing.
+        // Throws std::logic_error if the file was mapped read only.
+        std::span<E> writable_elements() {
+            if (!writable)
+                throw std::logic_error("Cannot write to an array file mapped as read only");
+            return {reinterpret_cast<E *>(static_cast<char *>(mapping) + header().data_offset), size()};
+        }
+
+        // Returns the elements for reading
+        std::span<const E> elements() const {
+            return {reinterpret_cast<const E *>(static_cast<const char *>(mapping) + header().data_offset), size()};
+        }
+
+        // Blocks until all writes through the mapping have reached the file
+        void flush() {
+            if (writable && msync(mapping, mapping_size, MS_SYNC) != 0)
+                throw std::runtime_error("Failed to flush array file");
+        }
+    };
+
+    // Writes the given elements into a new array file at path
+    template<typename E>
+    void write_array(const std::string &path, std::span<const E> elements) {
+        auto array = MappedArray<E>::create(path, elements.size());
+        if (!elements.empty())
+            std::memcpy(array.writable_elements().data(), elements.data(), elements.size_bytes());
+        array.flush();
+    }
+}
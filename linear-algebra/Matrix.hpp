@@ -1,23 +1,68 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <cassert>
 #include <iostream>
 #include <cmath>
+#include <stdexcept>
+#include <tuple>
 #include "Vector.hpp"
+#include "Backend.hpp"
 
 namespace LinearAlgebra {
-    template<unsigned int H, unsigned int W = H, typename T = double> requires std::is_integral<T>::value ||
-                                                                               std::is_floating_point<T>::value
+    template<unsigned int H, unsigned int W = H, typename T = double> requires Scalar<T>
     class Matrix {
     protected:
         std::array<std::array<T, W>, H> values;
 
+        // Reduces m to row echelon form in place with fraction-free (Bareiss) elimination over its first
+        // `columns` columns. Every division is exact, so integer matrices stay exact at O(n^3) cost.
+        // Returns the rank and the sign introduced by row swaps.
+        template<typename A, unsigned int C>
+        static std::tuple<unsigned int, int> bareiss(std::array<std::array<A, C>, H> &m, unsigned int columns) {
+            A previous = 1;
+            unsigned int rank = 0;
+            int sign = 1;
+
+            for (unsigned int c = 0; c < columns && rank < H; c++) {
+                unsigned int pivot = rank;
+                while (pivot < H && m[pivot][c] == 0) pivot++;
+                if (pivot == H) continue;
+                if (pivot != rank) {
+                    std::swap(m[pivot], m[rank]);
+                    sign = -sign;
+                }
+
+                for (unsigned int i = rank + 1; i < H; i++) {
+                    for (unsigned int j = c + 1; j < C; j++)
+                        m[i][j] = (m[i][j] * m[rank][c] - m[i][c] * m[rank][j]) / previous;
+                    m[i][c] = 0;
+                }
+                previous = m[rank][c];
+                rank++;
+            }
+
+            return std::make_tuple(rank, sign);
+        }
+
+        // Returns a copy of the values widened to type A
+        template<typename A>
+        std::array<std::array<A, W>, H> widened() const {
+            std::array<std::array<A, W>, H> m;
+            for (int i = 0; i < H; i++) for (int j = 0; j < W; j++) m[i][j] = (A) values[i][j];
+            return m;
+        }
+
     public:
         // Default constructor. Creates an identity matrix
         Matrix() {
-            for (int i = 0; i < H; i++) for (int j = 0; j < W; j++) values[i][j] = (i == j) ? 1 : 0;
+            unroll_2d<H, W>([&](unsigned int i, unsigned int j) { values[i][j] = (i == j) ? 1 : 0; });
         }
 
+        // Creates a matrix with uninitialised values, for results which are about to be overwritten
+        explicit Matrix(Uninitialised) {}
+
         // Initialises the matrix with the given values in row column order. Unspecified values are the identity.
         Matrix(std::initializer_list<T> args) : Matrix() {
             int cursor = 0;
@@ -51,14 +96,12 @@ namespace LinearAlgebra {
 
         // Construct r matrix from one of r different size. Undefined cells are made to be the identity.
         template<unsigned int H2, unsigned int W2>
-        explicit Matrix(Matrix<H2, W2, T> other) {
-            Matrix<H, W, T> m;
+        explicit Matrix(Matrix<H2, W2, T> other) : Matrix() {
             for (int i = 0; i < std::min(H, H2); i++) {
                 for (int j = 0; j < std::min(W, W2); j++) {
-                    m[i][j] = other[i][j];
+                    values[i][j] = other[i][j];
                 }
             }
-            return m;
         }
 
         // Mutable accessor
@@ -88,8 +131,9 @@ namespace LinearAlgebra {
 
         // Tests is 2 matrices are equal
         bool equals(const Matrix &b) const {
-            for (int i = 0; i < H; i++) for (int j = 0; j < W; j++) if ((*this)[i][j] != b[i][j]) return false;
-            return true;
+            bool equal = true;
+            unroll_2d<H, W>([&](unsigned int i, unsigned int j) { equal &= values[i][j] == b[i][j]; });
+            return equal;
         }
 
         // Operator overload for matrix equality
@@ -104,8 +148,8 @@ namespace LinearAlgebra {
 
         // Returns the piecewise sum result of 2 matrices
         Matrix plus(const Matrix &b) const {
-            Matrix sum;
-            for (int i = 0; i < H; i++) for (int j = 0; j < W; j++) sum[i][j] = (*this)[i][j] + b[i][j];
+            Matrix sum(uninitialised);
+            unroll_2d<H, W>([&](unsigned int i, unsigned int j) { sum[i][j] = values[i][j] + b[i][j]; });
             return sum;
         }
 
@@ -121,8 +165,8 @@ namespace LinearAlgebra {
 
         // Returns the piecewise difference of 2 matrices
         Matrix minus(const Matrix &b) const {
-            Matrix difference;
-            for (int i = 0; i < H; i++) for (int j = 0; j < W; j++) difference[i][j] = (*this)[i][j] - b[i][j];
+            Matrix difference(uninitialised);
+            unroll_2d<H, W>([&](unsigned int i, unsigned int j) { difference[i][j] = values[i][j] - b[i][j]; });
             return difference;
         }
 
@@ -138,8 +182,8 @@ namespace LinearAlgebra {
 
         // Scales r matrix by r given constant
         Matrix scale(T m) const {
-            Matrix scaled;
-            for (int i = 0; i < H; i++) for (int j = 0; j < W; j++) scaled[i][j] = m * (*this)[i][j];
+            Matrix scaled(uninitialised);
+            unroll_2d<H, W>([&](unsigned int i, unsigned int j) { scaled[i][j] = m * values[i][j]; });
             return scaled;
         }
 
@@ -153,30 +197,57 @@ namespace LinearAlgebra {
             (*this) = (*this).scale(b);
         }
 
-        // Multiplies 2 matrices together
+        // Multiplies 2 matrices together. Accumulates in accumulator_t<T>, or is run by BLAS for large float and
+        // double matrices when available.
         template<unsigned int D>
         Matrix<H, D, T> multiply_matrix(const Matrix<W, D, T> &b) const {
-            Matrix<H, D, T> multiply;
-            for (int i = 0; i < H; i++) {
-                for (int j = 0; j < W; j++) {
-                    T accumulator = 0;
-                    for (int k = 0; k < W; k++) accumulator += values[i][k] * b[k][j];
-                    multiply[i][j] = accumulator;
-                }
+            if constexpr (blas_supported<T> && (size_t) H * W * D >= BACKEND_MIN_OPERATIONS) {
+                Matrix<H, D, T> multiply(uninitialised);
+                Backend::gemm(BackendKind::Blas, H, W, D, (*this).data(), b.data(), multiply.data());
+                return multiply;
             }
+
+            // Each row of the product is accumulated as a sum of rows of b, so the inner operations run along
+            // contiguous rows and map directly onto vector instructions
+            Matrix<H, D, T> multiply(uninitialised);
+            unroll<H>([&](unsigned int i) {
+                std::array<accumulator_t<T>, D> row;
+                unroll<D>([&](unsigned int j) {
+                    row[j] = (accumulator_t<T>) values[i][0] * (accumulator_t<T>) b[0][j];
+                });
+                unroll<W - 1>([&](unsigned int k) {
+                    unroll<D>([&](unsigned int j) {
+                        row[j] += (accumulator_t<T>) values[i][k + 1] * (accumulator_t<T>) b[k + 1][j];
+                    });
+                });
+                unroll<D>([&](unsigned int j) { multiply[i][j] = (T) row[j]; });
+            });
             return multiply;
         }
 
         // Operator overload for matrix multiplication
         template<unsigned int D>
-        Matrix<D, D, T> operator*(const Matrix<H, D, T> &b) const {
+        Matrix<H, D, T> operator*(const Matrix<W, D, T> &b) const {
             return (*this).multiply_matrix(b);
         }
 
+        // Multiplies a vector by the matrix. Accumulates in accumulator_t<T>, or is run by BLAS for large float and
+        // double matrices when available.
         Vector <H, T> multiply_vector(const Vector <W, T> &v) const {
-            Vector<H, T> multiply;
-            for (int i = 0; i < H; i++)
-                multiply += v[i] * column_as_vector(i);
+            if constexpr (blas_supported<T> && (size_t) H * W >= BACKEND_MIN_OPERATIONS) {
+                Vector<H, T> multiply(uninitialised);
+                Backend::gemv(BackendKind::Blas, H, W, (*this).data(), v.data(), multiply.data());
+                return multiply;
+            }
+
+            Vector<H, T> multiply(uninitialised);
+            unroll<H>([&](unsigned int i) {
+                accumulator_t<T> accumulator = 0;
+                unroll<W>([&](unsigned int j) {
+                    accumulator += (accumulator_t<T>) values[i][j] * (accumulator_t<T>) v[j];
+                });
+                multiply[i] = (T) accumulator;
+            });
             return multiply;
         }
 
@@ -272,11 +343,14 @@ namespace LinearAlgebra {
             return (*this).remove_row(row).remove_column(col);
         }
 
-        // Calculates the determinant using cofactor and minors
+        // Calculates the determinant. Uses exact fraction-free elimination for integral types and
+        // cofactors and minors otherwise.
         T determinant() const {
             static_assert(H == W, "Cannot compute the determinant of r non-square matrix.");
 
-            if constexpr (H == 1 && W == 1) {
+            if constexpr (std::is_integral<T>::value) {
+                return (T) exact_determinant();
+            } else if constexpr (H == 1 && W == 1) {
                 return values[0][0];
             } else {
                 T accumulator = 0;
@@ -288,10 +362,64 @@ namespace LinearAlgebra {
             }
         }
 
+        // Calculates the determinant of an integral matrix exactly in O(n^3) using Bareiss elimination.
+        // Intermediate values are bounded by the determinants of sub-matrices, held in the accumulator type A.
+        template<typename A = long long>
+        A exact_determinant() const {
+            static_assert(H == W, "Cannot compute the determinant of r non-square matrix.");
+            static_assert(std::is_integral<T>::value && std::is_signed<A>::value,
+                          "Exact determinant requires an integral matrix and a signed accumulator");
+
+            auto m = widened<A>();
+            auto[rank, sign] = bareiss<A, W>(m, W);
+            if (rank < H) return 0;
+            return sign * m[H - 1][W - 1];
+        }
+
+        // Calculates the rank of an integral matrix exactly using Bareiss elimination
+        template<typename A = long long>
+        unsigned int rank() const {
+            static_assert(std::is_integral<T>::value && std::is_signed<A>::value,
+                          "Exact rank requires an integral matrix and a signed accumulator");
+
+            auto m = widened<A>();
+            return std::get<0>(bareiss<A, W>(m, W));
+        }
+
+        // Solves Ax = b exactly for an integral matrix A. Returns the numerators of x and their common denominator,
+        // which is the determinant of A up to sign.
+        // Throws std::invalid_argument when used on r singular matrix.
+        template<typename A = long long>
+        std::tuple<Vector<W, A>, A> solve_exact(const Vector<H, T> &b) const {
+            static_assert(H == W, "Cannot solve a non-square system exactly.");
+            static_assert(std::is_integral<T>::value && std::is_signed<A>::value,
+                          "Exact solve requires an integral matrix and a signed accumulator");
+
+            std::array<std::array<A, W + 1>, H> m;
+            for (int i = 0; i < H; i++) {
+                for (int j = 0; j < W; j++) m[i][j] = (A) values[i][j];
+                m[i][W] = (A) b[i];
+            }
+
+            auto[rank, sign] = bareiss<A, W + 1>(m, W);
+            if (rank < H)
+                throw std::invalid_argument("Cannot solve a singular system exactly");
+
+            // Fraction-free back substitution. Every division is exact by Cramer's rule.
+            A denominator = m[H - 1][W - 1];
+            Vector<W, A> x;
+            for (int i = H - 1; i >= 0; i--) {
+                A accumulator = denominator * m[i][W];
+                for (int j = i + 1; j < W; j++) accumulator -= m[i][j] * x[j];
+                x[i] = accumulator / m[i][i];
+            }
+            return std::make_tuple(x, denominator);
+        }
+
         // Transposes the matrix
-        Matrix<H, W, T> transpose() const {
-            Matrix<H, W, T> transpose;
-            for (int i = 0; i < H; i++) for (int j = 0; j < W; j++) transpose[i][j] = values[j][i];
+        Matrix<W, H, T> transpose() const {
+            Matrix<W, H, T> transpose(uninitialised);
+            unroll_2d<H, W>([&](unsigned int i, unsigned int j) { transpose[j][i] = values[i][j]; });
             return transpose;
         }
 
@@ -300,21 +428,201 @@ namespace LinearAlgebra {
             Matrix<H, W, T> adjugate;
             for (int i = 0; i < H; i++) {
                 for (int j = 0; j < W; j++) {
-                    double sign = ((i * W + j) % 2 == 0) ? 1 : -1;
+                    double sign = ((i + j) % 2 == 0) ? 1 : -1;
                     adjugate[i][j] = sign * this->minor(i, j).determinant();
                 }
             }
             return adjugate.transpose();
         }
 
-        // Calculates the inverse of r matrix.
-        // Throws std::invalid_argument when used on r singular matrix.
+        // Calculates the inverse of r matrix. Large float and double matrices are solved against the identity by
+        // BLAS when available. Throws std::invalid_argument when used on r singular matrix.
         Matrix<H, W, T> inverse() const {
-            double det = this->determinant();
-            if (det == 0.0)
-                throw std::invalid_argument("Cannot compute inverse of singular matrix");
-            else
-                return (1.0 / det) * this->adjugate();
+            if constexpr (blas_supported<T> && (size_t) H * H * H >= BACKEND_MIN_OPERATIONS) {
+                return (*this).solve(Matrix<H, W, T>());
+            } else {
+                double det = this->determinant();
+                if (det == 0.0)
+                    throw std::invalid_argument("Cannot compute inverse of singular matrix");
+                else
+                    return this->adjugate().scale((T) (1.0 / det));
+            }
+        }
+
+        // Returns an orthonormal matrix whose first k columns span the same space as the first k columns of this one,
+        // for every k, by Gram-Schmidt orthogonalisation. The first column keeps its direction and each later column
+        // is made orthogonal to those before it, so the result favours earlier columns and is not in general the
+        // closest orthonormal matrix. See polar_orthonormalised for that.
+        Matrix<H, W, T> orthonormalised() const {
+            static_assert(H == W, "Cannot orthonormalise a non-square matrix");
+            static_assert(!std::is_integral<T>::value, "Cannot orthonormalise an integral matrix");
+
+            Matrix<H, W, T> q(*this);
+            for (int j = 0; j < W; j++) {
+                for (int k = 0; k < j; k++) {
+                    T projection = 0;
+                    for (int i = 0; i < H; i++) projection += q[i][k] * q[i][j];
+                    for (int i = 0; i < H; i++) q[i][j] -= projection * q[i][k];
+                }
+                T length_squared = 0;
+                for (int i = 0; i < H; i++) length_squared += q[i][j] * q[i][j];
+                T inverse_length = 1 / std::sqrt(length_squared);
+                for (int i = 0; i < H; i++) q[i][j] *= inverse_length;
+            }
+            return q;
+        }
+
+        // Moves the matrix towards the orthonormal factor of its polar decomposition, which is the closest
+        // orthonormal matrix and treats every column equally. Each iteration X = X(3I - X^T X) / 2 needs only
+        // matrix products and roughly doubles the number of correct digits, but it only converges when the
+        // matrix is already close to orthonormal, as with rotations that have drifted through integration.
+        Matrix<H, W, T> polar_orthonormalised(unsigned int iterations = 2) const {
+            static_assert(H == W, "Cannot orthonormalise a non-square matrix");
+            static_assert(!std::is_integral<T>::value, "Cannot orthonormalise an integral matrix");
+
+            Matrix<H, W, T> x(*this);
+            for (unsigned int n = 0; n < iterations; n++) {
+                Matrix<H, W, T> correction = x.transpose().multiply_matrix(x).scale((T) -0.5);
+                for (int i = 0; i < H; i++) correction[i][i] += (T) 1.5;
+                x = x.multiply_matrix(correction);
+            }
+            return x;
+        }
+
+        // Solves AX = B for X by Gaussian elimination with partial pivoting, run by BLAS for large float and double
+        // matrices when available. Throws std::invalid_argument when used on r singular matrix.
+        template<unsigned int D>
+        Matrix<H, D, T> solve(const Matrix<H, D, T> &b) const {
+            static_assert(H == W, "Cannot solve a non-square system.");
+            static_assert(!std::is_integral<T>::value, "Use solve_exact for integral matrices.");
+            if constexpr (blas_supported<T> && (size_t) H * H * H >= BACKEND_MIN_OPERATIONS) {
+                Matrix<H, W, T> a(*this);
+                Matrix<H, D, T> x(b);
+                Backend::lu_solve(BackendKind::Blas, H, a.data(), D, x.data());
+                return x;
+            }
+
+            Matrix<H, W, T> a(*this);
+            Matrix<H, D, T> x(b);
+            for (int c = 0; c < W; c++) {
+                int pivot = c;
+                for (int i = c + 1; i < H; i++) if (std::abs(a[i][c]) > std::abs(a[pivot][c])) pivot = i;
+                if (a[pivot][c] == 0)
+                    throw std::invalid_argument("Cannot solve a singular system");
+                std::swap(a[pivot], a[c]);
+                std::swap(x[pivot], x[c]);
+
+                for (int i = c + 1; i < H; i++) {
+                    T factor = a[i][c] / a[c][c];
+                    for (int j = c; j < W; j++) a[i][j] -= factor * a[c][j];
+                    for (int j = 0; j < D; j++) x[i][j] -= factor * x[c][j];
+                }
+            }
+            for (int c = W - 1; c >= 0; c--) {
+                for (int j = 0; j < D; j++) {
+                    T accumulator = x[c][j];
+                    for (int k = c + 1; k < W; k++) accumulator -= a[c][k] * x[k][j];
+                    x[c][j] = accumulator / a[c][c];
+                }
+            }
+            return x;
+        }
+
+        // Raises the matrix to an integer power by repeated squaring, taking O(log n) products.
+        // Negative powers invert the matrix first.
+        // Throws std::invalid_argument for a negative power of r singular matrix.
+        Matrix<H, W, T> pow(int n) const {
+            static_assert(H == W, "Cannot raise a non-square matrix to a power.");
+
+            Matrix<H, W, T> base = n < 0 ? (*this).inverse() : (*this);
+            Matrix<H, W, T> result;
+            for (unsigned int e = n < 0 ? -(unsigned int) n : n; e > 0; e >>= 1) {
+                if (e & 1) result = result.multiply_matrix(base);
+                if (e > 1) base = base.multiply_matrix(base);
+            }
+            return result;
+        }
+
+        // Returns the skew-symmetric matrix [v]x for which [v]x u = v x u
+        static Matrix<H, W, T> skew(const Vector<3, T> &v) {
+            static_assert(H == 3 && W == 3, "Skew-symmetric matrices are only defined for 3x3 matrices");
+            return {0, -v[2], v[1],
+                    v[2], 0, -v[0],
+                    -v[1], v[0], 0};
+        }
+
+        // Calculates the matrix exponential.
+        // A 3x3 skew-symmetric matrix [w]x, the generator of a rotation, uses the closed form Rodrigues formula and
+        // gives the rotation by |w| radians about w. Other matrices use a degree 6 Pade approximant with scaling
+        // and squaring.
+        Matrix<H, W, T> exp() const {
+            static_assert(H == W, "Cannot take the exponential of a non-square matrix.");
+            static_assert(!std::is_integral<T>::value, "Cannot take the exponential of an integral matrix.");
+
+            if constexpr (H == 3) {
+                if ((*this).transpose() == (*this).scale(-1)) {
+                    T angle_squared = values[2][1] * values[2][1] + values[0][2] * values[0][2] +
+                                      values[1][0] * values[1][0];
+                    T angle = std::sqrt(angle_squared);
+                    // sin(x) / x and (1 - cos(x)) / x^2, using their Taylor series near 0
+                    T a = angle > 1e-4 ? std::sin(angle) / angle : 1 - angle_squared / 6;
+                    T b = angle > 1e-4 ? (1 - std::cos(angle)) / angle_squared : (T) 0.5 - angle_squared / 24;
+                    return Matrix<H, W, T>() + (*this).scale(a) + (*this).multiply_matrix(*this).scale(b);
+                }
+            }
+
+            // Scale so that the infinity norm is at most 1/2, where the approximant is accurate to double precision
+            T norm = 0;
+            for (int i = 0; i < H; i++) {
+                T row = 0;
+                for (int j = 0; j < W; j++) row += std::abs(values[i][j]);
+                norm = std::max(norm, row);
+            }
+            int squarings = norm > 0.5 ? (int) std::ceil(std::log2(norm / 0.5)) : 0;
+            Matrix<H, W, T> a = (*this).scale((T) std::ldexp(1.0, -squarings));
+
+            constexpr int Q = 6;
+            Matrix<H, W, T> numerator, denominator, power;
+            T c = 1;
+            for (int k = 1; k <= Q; k++) {
+                c = c * (Q - k + 1) / (k * (2 * Q - k + 1));
+                power = a.multiply_matrix(power);
+                numerator += power.scale(c);
+                denominator += power.scale(k % 2 == 0 ? c : -c);
+            }
+
+            Matrix<H, W, T> result = denominator.solve(numerator);
+            for (int n = 0; n < squarings; n++) result = result.multiply_matrix(result);
+            return result;
+        }
+
+        // Calculates the logarithm of a 3x3 rotation matrix: the skew-symmetric generator [w]x whose exponential
+        // is the rotation, with |w| in [0, pi]. The result is only meaningful for rotation matrices.
+        Matrix<H, W, T> log() const {
+            static_assert(H == 3 && W == 3, "Logarithm is only defined for 3x3 rotation matrices");
+            static_assert(!std::is_integral<T>::value, "Cannot take the logarithm of an integral matrix.");
+
+            T cosine = std::clamp((values[0][0] + values[1][1] + values[2][2] - 1) / 2, (T) -1, (T) 1);
+            T angle = std::acos(cosine);
+            Vector<3, T> axis{values[2][1] - values[1][2], values[0][2] - values[2][0], values[1][0] - values[0][1]};
+
+            if (angle < 1e-4) {
+                // sin(x) / x tends to 1, so the generator is the skew-symmetric part
+                return skew(axis.scale((T) 0.5));
+            } else if (M_PI - angle < 1e-4) {
+                // The skew-symmetric part vanishes near pi, so recover the axis from the symmetric part, which is
+                // cos(angle) I + (1 - cos(angle)) n nᵀ. Removing cos(angle) I leaves a column parallel to n.
+                int largest = 0;
+                for (int i = 1; i < 3; i++) if (values[i][i] > values[largest][largest]) largest = i;
+                Vector<3, T> symmetric_axis;
+                for (int i = 0; i < 3; i++) symmetric_axis[i] = (values[i][largest] + values[largest][i]) / 2;
+                symmetric_axis[largest] -= cosine;
+                // The symmetric part only fixes the axis up to sign, which the skew-symmetric part still gives
+                if (symmetric_axis.dot_product(axis) < 0) symmetric_axis = -symmetric_axis;
+                return skew(symmetric_axis.normalised().scale(angle));
+            } else {
+                return skew(axis.scale(angle / (2 * std::sin(angle))));
+            }
         }
 
         // Returns raw pointer to internal data
@@ -345,6 +653,60 @@ namespace LinearAlgebra {
             for (int i = 0; i < H - 1; i++) translate[i][W - 1] = offset[i];
             return translate;
         }
+
+        // Creates a 4x4 perspective projection from view space, looking down -z, to clip space with z in [-w, w].
+        // The vertical field of view is given in radians.
+        static Matrix<H, W, T> perspective(T fov_y, T aspect, T near, T far) {
+            static_assert(H == 4 && W == 4, "Perspective matrices are only defined for 4x4 matrices");
+            static_assert(!std::is_integral<T>::value, "Perspective matrices are not defined for integral types");
+
+            T f = 1 / std::tan(fov_y / 2);
+            Matrix<H, W, T> projection;
+            projection[0][0] = f / aspect;
+            projection[1][1] = f;
+            projection[2][2] = (far + near) / (near - far);
+            projection[2][3] = 2 * far * near / (near - far);
+            projection[3][2] = -1;
+            projection[3][3] = 0;
+            return projection;
+        }
+
+        // Creates a 4x4 orthographic projection mapping the given view space box onto the cube [-1, 1]^3.
+        static Matrix<H, W, T> orthographic(T left, T right, T bottom, T top, T near, T far) {
+            static_assert(H == 4 && W == 4, "Orthographic matrices are only defined for 4x4 matrices");
+            static_assert(!std::is_integral<T>::value, "Orthographic matrices are not defined for integral types");
+
+            Matrix<H, W, T> projection;
+            projection[0][0] = 2 / (right - left);
+            projection[1][1] = 2 / (top - bottom);
+            projection[2][2] = -2 / (far - near);
+            projection[0][3] = -(right + left) / (right - left);
+            projection[1][3] = -(top + bottom) / (top - bottom);
+            projection[2][3] = -(far + near) / (far - near);
+            return projection;
+        }
+
+        // Creates a 4x4 view matrix for a camera at eye looking towards target, with the given up direction.
+        // The camera looks down -z in view space.
+        static Matrix<H, W, T> look_at(const Vector<3, T> &eye, const Vector<3, T> &target, const Vector<3, T> &up) {
+            static_assert(H == 4 && W == 4, "Look at matrices are only defined for 4x4 matrices");
+            static_assert(!std::is_integral<T>::value, "Look at matrices are not defined for integral types");
+
+            Vector<3, T> forward = (target - eye).normalised();
+            Vector<3, T> side = forward.cross_product(up).normalised();
+            Vector<3, T> camera_up = side.cross_product(forward);
+
+            Matrix<H, W, T> view;
+            for (int i = 0; i < 3; i++) {
+                view[0][i] = side[i];
+                view[1][i] = camera_up[i];
+                view[2][i] = -forward[i];
+            }
+            view[0][3] = -side.dot_product(eye);
+            view[1][3] = -camera_up.dot_product(eye);
+            view[2][3] = forward.dot_product(eye);
+            return view;
+        }
     };
 
     // Overloads operator to make scalar multiplication commutative
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cmath>
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include "Vector.hpp"
+#include "Parallel.hpp"
+
+namespace LinearAlgebra {
+    // The triangles using each vertex, stored in compressed rows: the triangles of vertex v are
+    // triangles[offsets[v]] up to triangles[offsets[v + 1]]. Lets per vertex sums be gathered in parallel
+    // without threads writing to the same vertex.
+    struct VertexAdjacency {
+        std::vector<unsigned int> offsets;
+        std::vector<unsigned int> triangles;
+
+        // Builds the adjacency of a triangle list.
+        // Throws std::invalid_argument if the index count is not a multiple of 3 or an index is out of range.
+        static VertexAdjacency build(size_t vertex_count, std::span<const unsigned int> indices) {
+            if (indices.size() % 3 != 0)
+                throw std::invalid_argument("Triangle list must have 3 indices per triangle");
+
+            VertexAdjacency adjacency;
+            adjacency.offsets.assign(vertex_count + 1, 0);
+            for (unsigned int index: indices) {
+                if (index >= vertex_count)
+                    throw std::invalid_argument("Triangle index outside of the vertex array");
+                adjacency.offsets[index + 1]++;
+            }
+            for (size_t v = 0; v < vertex_count; v++) adjacency.offsets[v + 1] += adjacency.offsets[v];
+
+            std::vector<unsigned int> cursor(adjacency.offsets.begin(), adjacency.offsets.end() - 1);
+            adjacency.triangles.resize(indices.size());
+            for (size_t i = 0; i < indices.size(); i++)
+                adjacency.triangles[cursor[indices[i]]++] = (unsigned int) (i / 3);
+            return adjacency;
+        }
+    };
+
+    // Computes area weighted vertex normals of a triangle list.
+    // Face normals are computed in parallel over triangles, then summed in parallel over vertices through the
+    // vertex adjacency. Vertices used by no triangle, or only by degenerate ones, get a zero normal.
+    // Throws std::invalid_argument if the arrays are inconsistent.
+    inline void compute_vertex_normals(std::span<const Vec3> positions, std::span<const unsigned int> indices,
+                                       std::span<Vec3> normals) {
+        if (normals.size() != positions.size())
+            throw std::invalid_argument("Normal array must have one entry per vertex");
+        VertexAdjacency adjacency = VertexAdjacency::build(positions.size(), indices);
+
+        // The cross product of two edges has length twice the triangle area, giving the area weighting
+        std::vector<Vec3> face_normals(indices.size() / 3);
+        parallel_for(face_normals.size(), [&](size_t begin, size_t end) {
+            for (size_t t = begin; t < end; t++) {
+                const Vec3 &a = positions[indices[3 * t]];
+                Vec3 ab = positions[indices[3 * t + 1]] - a;
+                face_normals[t] = ab.cross_product(positions[indices[3 * t + 2]] - a);
+            }
+        });
+
+        parallel_for(positions.size(), [&](size_t begin, size_t end) {
+            for (size_t v = begin; v < end; v++) {
+                Vec3 sum;
+                for (unsigned int n = adjacency.offsets[v]; n < adjacency.offsets[v + 1]; n++)
+                    sum += face_normals[adjacency.triangles[n]];
+                normals[v] = sum.normalised_fast();
+            }
+        });
+    }
+
+    // Computes per vertex tangents of a triangle list from its texture coordinates, in the style of MikkTSpace.
+    // Each tangent is orthogonalised against the vertex normal and its w component holds the handedness,
+    // such that bitangent = w * cross(normal, tangent). Triangles with degenerate texture coordinates are skipped.
+    // Throws std::invalid_argument if the arrays are inconsistent.
+    inline void compute_vertex_tangents(std::span<const Vec3> positions, std::span<const Vec2> uvs,
+                                        std::span<const Vec3> normals, std::span<const unsigned int> indices,
+                                        std::span<Vec4> tangents) {
+        if (uvs.size() != positions.size() || normals.size() != positions.size() ||
+            tangents.size() != positions.size())
+            throw std::invalid_argument("Tangent inputs and outputs must have one entry per vertex");
+        VertexAdjacency adjacency = VertexAdjacency::build(positions.size(), indices);
+
+        // Tangent and bitangent of each triangle, weighted by area like the normals
+        std::vector<Vec3> face_tangents(indices.size() / 3), face_bitangents(indices.size() / 3);
+        parallel_for(face_tangents.size(), [&](size_t begin, size_t end) {
+            for (size_t t = begin; t < end; t++) {
+                unsigned int a = indices[3 * t], b = indices[3 * t + 1], c = indices[3 * t + 2];
+                Vec3 e1 = positions[b] - positions[a], e2 = positions[c] - positions[a];
+                Vec2 d1 = uvs[b] - uvs[a], d2 = uvs[c] - uvs[a];
+                double determinant = d1[0] * d2[1] - d2[0] * d1[1];
+                if (std::abs(determinant) < 1e-20) continue;
+
+                // Normalised before weighting so that how far the texture is stretched does not affect the weight
+                double area = e1.cross_product(e2).length(), r = 1.0 / determinant;
+                face_tangents[t] = ((e1 * d2[1] - e2 * d1[1]) * r).normalised_fast() * area;
+                face_bitangents[t] = ((e2 * d1[0] - e1 * d2[0]) * r).normalised_fast() * area;
+            }
+        });
+
+        parallel_for(positions.size(), [&](size_t begin, size_t end) {
+            for (size_t v = begin; v < end; v++) {
+                Vec3 tangent, bitangent;
+                for (unsigned int n = adjacency.offsets[v]; n < adjacency.offsets[v + 1]; n++) {
+                    tangent += face_tangents[adjacency.triangles[n]];
+                    bitangent += face_bitangents[adjacency.triangles[n]];
+                }
+
+                Vec3 normal = normals[v];
+                tangent = (tangent - normal * normal.dot_product(tangent)).normalised_fast();
+                // Fall back to any direction perpendicular to the normal when no triangle gave a tangent
+                if (tangent.length_squared() == 0) {
+                    Vec3 axis = std::abs(normal[0]) < 0.9 ? Vec3{1, 0, 0} : Vec3{0, 1, 0};
+                    tangent = normal.cross_product(axis).normalised_fast();
+                }
+
+                double handedness = normal.cross_product(tangent).dot_product(bitangent) < 0 ? -1.0 : 1.0;
+                tangents[v] = tangent.append(handedness);
+            }
+        });
+    }
+}
@@ -1,6 +1,9 @@
 #pragma once
 
 #include <cmath>
+#include <span>
+#include "FastMath.hpp"
+#include "Matrix.hpp"
 
 namespace LinearAlgebra {
     // Struct representing a 2d orientation. Only uses one angle as to describe.
@@ -187,26 +190,81 @@ namespace LinearAlgebra {
             return multiply(*this, b);
         }
 
+        // Returns the conjugate of the quaternion
+        Quaternion conjugate() const {
+            return {r, -i, -j, -k};
+        }
+
+        // Returns the dot product of the quaternions as 4 vectors
+        static double dot_product(const Quaternion &a, const Quaternion &b) {
+            return a.r * b.r + a.i * b.i + a.j * b.j + a.k * b.k;
+        }
+
         // Return the inverse of the quaternion
         Quaternion inverse() const {
             return Quaternion(real_part(), -vector_part());
         }
 
+        // Calculates the squared euclidean magnitude of the quaternion
+        double magnitude_squared() const {
+            return r * r + i * i + j * j + k * k;
+        }
+
         // Calculates the euclidean magnitude of the quaternion
         double magnitude() const {
-            double mag_squared = r * r + i * i + j * j + k * k;
-            return sqrt(mag_squared);
+            return sqrt(magnitude_squared());
+        }
+
+        // Returns the quaternion scaled to unit magnitude
+        Quaternion normalised() const {
+            return multiply(1.0 / magnitude(), *this);
+        }
+
+        // Returns the quaternion scaled to unit magnitude using a fast reciprocal square root.
+        // The magnitude of the result is within 1e-12 of 1. The zero quaternion is returned unchanged.
+        Quaternion normalised_fast() const {
+            double magnitude_squared = (*this).magnitude_squared();
+            double inverse = reciprocal_sqrt(magnitude_squared);
+            return multiply(magnitude_squared > 0 ? inverse : 0, *this);
+        }
+
+        // Normalises the quaternion
+        void normalise() {
+            (*this) = normalised();
         }
 
         // Returns the rotation represented by the quaternion as a matrix
         Mat3 as_matrix() const {
-            double s = 1.0 / magnitude() * magnitude();
+            double s = 1.0 / (magnitude() * magnitude());
 
             return {
-                    1 - 2 * s * (j * j + k + k), 2 * s * (i * j - k * r), 2 * s * (i * k + j * r),
+                    1 - 2 * s * (j * j + k * k), 2 * s * (i * j - k * r), 2 * s * (i * k + j * r),
                     2 * s * (i * j + k * r), 1 - 2 * s * (i * i + k * k), 2 * s * (j * k - i * r),
                     2 * s * (i * k - j * r), 2 * s * (j * k + i * r), 1 - 2 * s * (i * i + j * j)
             };
         }
+
+        // Constructs the unit quaternion representing the rotation described by an orthonormal matrix
+        static Quaternion from_matrix(const Mat3 &m) {
+            double trace = m[0][0] + m[1][1] + m[2][2];
+            if (trace > 0) {
+                double s = 0.5 / sqrt(trace + 1.0);
+                return {0.25 / s, (m[2][1] - m[1][2]) * s, (m[0][2] - m[2][0]) * s, (m[1][0] - m[0][1]) * s};
+            } else if (m[0][0] > m[1][1] && m[0][0] > m[2][2]) {
+                double s = 2.0 * sqrt(1.0 + m[0][0] - m[1][1] - m[2][2]);
+                return {(m[2][1] - m[1][2]) / s, 0.25 * s, (m[0][1] + m[1][0]) / s, (m[0][2] + m[2][0]) / s};
+            } else if (m[1][1] > m[2][2]) {
+                double s = 2.0 * sqrt(1.0 + m[1][1] - m[0][0] - m[2][2]);
+                return {(m[0][2] - m[2][0]) / s, (m[0][1] + m[1][0]) / s, 0.25 * s, (m[1][2] + m[2][1]) / s};
+            } else {
+                double s = 2.0 * sqrt(1.0 + m[2][2] - m[0][0] - m[1][1]);
+                return {(m[1][0] - m[0][1]) / s, (m[0][2] + m[2][0]) / s, (m[1][2] + m[2][1]) / s, 0.25 * s};
+            }
+        }
     };
+
+    // Normalises every quaternion in place with normalised_fast
+    inline void normalise_all(std::span<Quaternion> quaternions) {
+        for (auto &q: quaternions) q = q.normalised_fast();
+    }
 }
\ No newline at end of file
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <span>
+#include "Matrix.hpp"
+#include "Orientation.hpp"
+#include "Parallel.hpp"
+
+namespace LinearAlgebra {
+    // Method used to correct the drift of rotation matrices
+    enum class OrthonormaliseMethod {
+        // Gram-Schmidt orthogonalisation. Exact in one pass but biased towards the first column.
+        GramSchmidt,
+        // Polar iteration. Treats every column equally but needs the matrices to be close to orthonormal.
+        Polar
+    };
+
+    namespace Detail {
+        template<typename T>
+        void orthonormalise_all(std::span<Matrix<3, 3, T>> matrices, OrthonormaliseMethod method,
+                                unsigned int iterations) {
+            parallel_for(matrices.size(), [&](size_t begin, size_t end) {
+                if (method == OrthonormaliseMethod::GramSchmidt)
+                    for (size_t n = begin; n < end; n++) matrices[n] = matrices[n].orthonormalised();
+                else
+                    for (size_t n = begin; n < end; n++) matrices[n] = matrices[n].polar_orthonormalised(iterations);
+            });
+        }
+    }
+
+    // Corrects the drift of every rotation matrix in place, splitting the work across threads.
+    // iterations is only used by the polar method.
+    inline void orthonormalise_all(std::span<Mat3> matrices,
+                                   OrthonormaliseMethod method = OrthonormaliseMethod::GramSchmidt,
+                                   unsigned int iterations = 2) {
+        Detail::orthonormalise_all(matrices, method, iterations);
+    }
+
+    // Corrects the drift of every rotation matrix in place, splitting the work across threads.
+    // iterations is only used by the polar method.
+    inline void orthonormalise_all(std::span<Mat3f> matrices,
+                                   OrthonormaliseMethod method = OrthonormaliseMethod::GramSchmidt,
+                                   unsigned int iterations = 2) {
+        Detail::orthonormalise_all(matrices, method, iterations);
+    }
+
+    // Corrects the drift of every rotation quaternion in place, splitting the work across threads
+    inline void renormalise_all(std::span<Quaternion> quaternions) {
+        parallel_for(quaternions.size(), [&](size_t begin, size_t end) {
+            normalise_all(quaternions.subspan(begin, end - begin));
+        });
+    }
+}
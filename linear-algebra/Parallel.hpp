@@ -0,0 +1,40 @@
+#pragma once
+
+#include <algorithm>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace LinearAlgebra {
+    // Calls body(begin, end) over contiguous ranges covering [0, count), spread across the hardware threads.
+    // Each thread is given at least grain items, so small workloads run on the calling thread alone.
+    // The first exception thrown by any range is rethrown once every thread has finished.
+    template<typename F>
+    void parallel_for(size_t count, F body, size_t grain = 1024) {
+        size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+        size_t threads = std::min(hardware, std::max<size_t>(1, count / std::max<size_t>(1, grain)));
+
+        if (threads <= 1) {
+            if (count > 0) body((size_t) 0, count);
+            return;
+        }
+
+        std::vector<std::thread> workers;
+        std::vector<std::exception_ptr> errors(threads);
+        size_t step = (count + threads - 1) / threads;
+        for (size_t t = 0; t < threads; t++) {
+            size_t begin = t * step, end = std::min(count, begin + step);
+            if (begin >= end) break;
+            workers.emplace_back([&body, &errors, t, begin, end]() {
+                try {
+                    body(begin, end);
+                } catch (...) {
+                    errors[t] = std::current_exception();
+                }
+            });
+        }
+
+        for (auto &worker: workers) worker.join();
+        for (auto &error: errors) if (error) std::rethrow_exception(error);
+    }
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <array>
+#include <future>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+#include "Vector.hpp"
+#include "Matrix.hpp"
+#include "Orientation.hpp"
+
+namespace LinearAlgebra {
+    // A chain of transforms applied to streams of 3D points which are too large to hold in memory.
+    // Points are read and written as raw Vector<3, T> values.
+    template<typename T = double>
+    class TransformPipeline {
+    private:
+        // The composition of every transform in the chain
+        Matrix<4, 4, T> transform;
+
+        // Reads up to count points into buffer. Returns the number read, which is only 0 at the end of the stream.
+        static size_t read_chunk(std::istream &in, Vector<3, T> *buffer, size_t count) {
+            in.read(reinterpret_cast<char *>(buffer), (std::streamsize) (count * sizeof(Vector<3, T>)));
+            size_t bytes = in.gcount();
+            // A failed read also stops early, and must not be mistaken for the end of the stream
+            if (in.bad())
+                throw std::runtime_error("Failed to read from point stream");
+            if (bytes % sizeof(Vector<3, T>) != 0)
+                throw std::runtime_error("Point stream ended part way through a point");
+            return bytes / sizeof(Vector<3, T>);
+        }
+
+        // Writes count points from buffer
+        static void write_chunk(std::ostream &out, const Vector<3, T> *buffer, size_t count) {
+            out.write(reinterpret_cast<const char *>(buffer), (std::streamsize) (count * sizeof(Vector<3, T>)));
+            if (!out)
+                throw std::runtime_error("Failed to write to point stream");
+        }
+
+    public:
+        // Creates an empty pipeline which leaves points unchanged
+        TransformPipeline() = default;
+
+        // Appends a homogeneous transform, applied after those already in the pipeline
+        TransformPipeline &then(const Matrix<4, 4, T> &m) {
+            transform = m * transform;
+            return *this;
+        }
+
+        // Appends a linear transform, applied after those already in the pipeline
+        TransformPipeline &then(const Matrix<3, 3, T> &m) {
+            return then(Matrix<4, 4, T>(m));
+        }
+
+        // Appends a rotation, applied after those already in the pipeline
+        TransformPipeline &then(const Quaternion &q) {
+            Mat3 rotation = q.as_matrix();
+            return then(Matrix<3, 3, T>([&rotation](unsigned int i, unsigned int j) { return (T) rotation[i][j]; }));
+        }
+
+        // Returns the composed transform
+        const Matrix<4, 4, T> &matrix() const {
+            return transform;
+        }
+
+        // Transforms count points in place
+        void apply(Vector<3, T> *points, size_t count) const {
+            const auto &m = transform;
+            bool affine = m[3][0] == 0 && m[3][1] == 0 && m[3][2] == 0 && m[3][3] == 1;
+
+            for (size_t n = 0; n < count; n++) {
+                T x = points[n][0], y = points[n][1], z = points[n][2];
+                T tx = m[0][0] * x + m[0][1] * y + m[0][2] * z + m[0][3];
+                T ty = m[1][0] * x + m[1][1] * y + m[1][2] * z + m[1][3];
+                T tz = m[2][0] * x + m[2][1] * y + m[2][2] * z + m[2][3];
+                if (!affine) {
+                    T w = m[3][0] * x + m[3][1] * y + m[3][2] * z + m[3][3];
+                    tx /= w;
+                    ty /= w;
+                    tz /= w;
+                }
+                points[n] = {tx, ty, tz};
+            }
+        }
+
+        // Transforms every point from in and writes it to out, chunk_size points at a time.
+        // Reading the next chunk and writing the previous one overlap with transforming the current one,
+        // so at most 3 chunks are held in memory at once. Returns the number of points processed.
+        // Throws std::runtime_error if the input cannot be read or ends part way through a point, or the output
+        // cannot be written.
+        size_t process(std::istream &in, std::ostream &out, size_t chunk_size = 1 << 16) const {
+            if (chunk_size == 0)
+                throw std::invalid_argument("Chunk size must be greater than 0");
+
+            std::array<std::vector<Vector<3, T>>, 3> buffers;
+            for (auto &buffer: buffers) buffer.resize(chunk_size);
+
+            size_t total = 0;
+            unsigned int current = 0;
+            std::future<size_t> reading = std::async(std::launch::async, read_chunk, std::ref(in),
+                                                     buffers[current].data(), chunk_size);
+            std::future<void> writing;
+
+            while (true) {
+                size_t count = reading.get();
+                if (count == 0) break;
+
+                unsigned int next = (current + 1) % buffers.size();
+                reading = std::async(std::launch::async, read_chunk, std::ref(in), buffers[next].data(), chunk_size);
+
+                apply(buffers[current].data(), count);
+
+                if (writing.valid()) writing.get();
+                writing = std::async(std::launch::async, write_chunk, std::ref(out), buffers[current].data(), count);
+
+                total += count;
+                current = next;
+            }
+
+            if (writing.valid()) writing.get();
+            return total;
+        }
+    };
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cerrno>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <sched.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace LinearAlgebra {
+    // The CPUs of each NUMA node this process may run on, read from /sys/devices/system/node. Machines without NUMA
+    // information are treated as a single node holding every allowed CPU.
+    struct NumaTopology {
+        std::vector<std::vector<int>> nodes;
+
+        // Reads the topology of the machine, restricted to the CPUs in this process's affinity mask
+        static NumaTopology detect() {
+            cpu_set_t allowed;
+            CPU_ZERO(&allowed);
+            if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+                throw std::runtime_error("Failed to read the CPU affinity of the process");
+
+            NumaTopology topology;
+            for (int node = 0;; node++) {
+                std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+                if (!file) break;
+                std::string list;
+                std::getline(file, list);
+
+                // The list is comma separated CPUs and inclusive ranges, such as "0-3,8-11"
+                std::vector<int> cpus;
+                size_t position = 0;
+                while (position < list.size()) {
+                    size_t end = list.find(',', position);
+                    if (end == std::string::npos) end = list.size();
+                    std::string range = list.substr(position, end - position);
+                    size_t dash = range.find('-');
+                    if (!range.empty()) {
+                        int first = std::stoi(range.substr(0, dash));
+                        int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+                        for (int cpu = first; cpu <= last; cpu++) if (CPU_ISSET(cpu, &allowed)) cpus.push_back(cpu);
+                    }
+                    position = end + 1;
+                }
+                if (!cpus.empty()) topology.nodes.push_back(cpus);
+            }
+
+            if (topology.nodes.empty()) {
+                topology.nodes.emplace_back();
+                for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+                    if (CPU_ISSET(cpu, &allowed)) topology.nodes.back().push_back(cpu);
+            }
+            return topology;
+        }
+
+        // Restricts the calling process to the CPUs of the node that worker is placed on. Workers are spread over
+        // the nodes in turn, so memory the worker touches first is allocated on its own node.
+        void pin(unsigned int worker) const {
+            const std::vector<int> &cpus = nodes[worker % nodes.size()];
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            for (int cpu: cpus) CPU_SET(cpu, &set);
+            if (sched_setaffinity(0, sizeof(set), &set) != 0)
+                throw std::runtime_error("Failed to set the CPU affinity of a worker process");
+        }
+    };
+
+    // Calls body(worker) for each worker from 0 to count - 1 in its own forked process, each pinned to a NUMA node
+    // of the topology, and waits for all of them. Workers share memory with the caller only through shared
+    // mappings made before the call, such as SharedSegment.
+    // Only the calling thread is copied into each worker, so no other thread may be running when this is called.
+    // A lock held by another thread at the fork, such as one inside malloc or a threaded BLAS, would never be
+    // released in the worker and the worker could deadlock as soon as it allocated or called BLAS. The library's own
+    // parallel_for joins its threads before returning, so it is safe to use before and inside the workers.
+    // Throws std::runtime_error if a worker cannot be started, or exits by an exception or signal.
+    template<typename F>
+    void fork_workers(unsigned int count, const NumaTopology &topology, F body) {
+        std::vector<pid_t> workers;
+        bool started = true;
+        for (unsigned int worker = 0; worker < count; worker++) {
+            pid_t pid = fork();
+            if (pid < 0) {
+                started = false;
+                break;
+            }
+            if (pid == 0) {
+                // The worker must not return into the caller or run its exit handlers
+                int status = 0;
+                try {
+                    topology.pin(worker);
+                    body(worker);
+                } catch (...) {
+                    status = 1;
+                }
+                _exit(status);
+            }
+            workers.push_back(pid);
+        }
+
+        bool succeeded = started;
+        for (pid_t pid: workers) {
+            int status = 0;
+            pid_t result;
+            do result = waitpid(pid, &status, 0); while (result < 0 && errno == EINTR);
+            succeeded &= result == pid && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+        }
+        if (!started)
+            throw std::runtime_error("Failed to start a worker process");
+        if (!succeeded)
+            throw std::runtime_error("A worker process failed");
+    }
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <span>
+#include <stdexcept>
+#include "Vector.hpp"
+#include "Matrix.hpp"
+#include "Parallel.hpp"
+
+namespace LinearAlgebra {
+    // A perspective projection stored as only the 6 coefficients which vary, the rest being 0 or -1.
+    // Covers symmetric and off-centre frusta as built by Matrix::perspective. Projecting a point takes 8
+    // multiplies and a single division instead of a dense 4x4 product followed by 3 divisions.
+    template<typename T = double>
+    struct PerspectiveProjection {
+        // Row 0 and 1 scale and skew x and y, row 2 maps depth and w = -z
+        T x_scale, x_skew, y_scale, y_skew, z_scale, z_offset;
+
+        // Construct from the parameters of Matrix::perspective
+        PerspectiveProjection(T fov_y, T aspect, T near, T far)
+                : PerspectiveProjection(Matrix<4, 4, T>::perspective(fov_y, aspect, near, far)) {}
+
+        // Construct from a perspective projection matrix.
+        // Throws std::invalid_argument if the matrix does not have the perspective zero pattern.
+        explicit PerspectiveProjection(const Matrix<4, 4, T> &m)
+                : x_scale(m[0][0]), x_skew(m[0][2]), y_scale(m[1][1]), y_skew(m[1][2]),
+                  z_scale(m[2][2]), z_offset(m[2][3]) {
+            if (m[0][1] != 0 || m[0][3] != 0 || m[1][0] != 0 || m[1][3] != 0 || m[2][0] != 0 || m[2][1] != 0 ||
+                m[3][0] != 0 || m[3][1] != 0 || m[3][2] != -1 || m[3][3] != 0)
+                throw std::invalid_argument("Matrix is not a perspective projection");
+        }
+
+        // Returns the projection as a dense matrix
+        Matrix<4, 4, T> as_matrix() const {
+            return {x_scale, 0, x_skew, 0,
+                    0, y_scale, y_skew, 0,
+                    0, 0, z_scale, z_offset,
+                    0, 0, -1, 0};
+        }
+
+        // Projects a point in view space to normalised device coordinates, including the perspective divide
+        Vector<3, T> project(const Vector<3, T> &p) const {
+            T inverse_w = -1 / p[2];
+            return {(x_scale * p[0] + x_skew * p[2]) * inverse_w,
+                    (y_scale * p[1] + y_skew * p[2]) * inverse_w,
+                    (z_scale * p[2] + z_offset) * inverse_w};
+        }
+
+        // Recovers the view space point which projects onto the given normalised device coordinates
+        Vector<3, T> unproject(const Vector<3, T> &ndc) const {
+            T z = -z_offset / (ndc[2] + z_scale);
+            return {(-ndc[0] * z - x_skew * z) / x_scale,
+                    (-ndc[1] * z - y_skew * z) / y_scale,
+                    z};
+        }
+
+        // Projects every point to normalised device coordinates, splitting the work across threads.
+        // Throws std::invalid_argument if the arrays differ in length.
+        void project_all(std::span<const Vector<3, T>> points, std::span<Vector<3, T>> ndc) const {
+            if (points.size() != ndc.size())
+                throw std::invalid_argument("Cannot project points into an array of a different length");
+            parallel_for(points.size(), [&](size_t begin, size_t end) {
+                for (size_t n = begin; n < end; n++) ndc[n] = project(points[n]);
+            });
+        }
+    };
+
+    // An orthographic projection stored as a scale and offset per axis, as built by Matrix::orthographic
+    template<typename T = double>
+    struct OrthographicProjection {
+        Vector<3, T> scale, offset;
+
+        // Construct from the parameters of Matrix::orthographic
+        OrthographicProjection(T left, T right, T bottom, T top, T near, T far)
+                : OrthographicProjection(Matrix<4, 4, T>::orthographic(left, right, bottom, top, near, far)) {}
+
+        // Construct from an orthographic projection matrix.
+        // Throws std::invalid_argument if the matrix does not have the orthographic zero pattern.
+        explicit OrthographicProjection(const Matrix<4, 4, T> &m)
+                : scale{m[0][0], m[1][1], m[2][2]}, offset{m[0][3], m[1][3], m[2][3]} {
+            for (int i = 0; i < 4; i++)
+                for (int j = 0; j < 3; j++)
+                    if (i != j && m[i][j] != 0)
+                        throw std::invalid_argument("Matrix is not an orthographic projection");
+            if (m[3][3] != 1)
+                throw std::invalid_argument("Matrix is not an orthographic projection");
+        }
+
+        // Returns the projection as a dense matrix
+        Matrix<4, 4, T> as_matrix() const {
+            return {scale[0], 0, 0, offset[0],
+                    0, scale[1], 0, offset[1],
+                    0, 0, scale[2], offset[2],
+                    0, 0, 0, 1};
+        }
+
+        // Projects a point in view space to normalised device coordinates
+        Vector<3, T> project(const Vector<3, T> &p) const {
+            return {scale[0] * p[0] + offset[0], scale[1] * p[1] + offset[1], scale[2] * p[2] + offset[2]};
+        }
+
+        // Recovers the view space point which projects onto the given normalised device coordinates
+        Vector<3, T> unproject(const Vector<3, T> &ndc) const {
+            return {(ndc[0] - offset[0]) / scale[0], (ndc[1] - offset[1]) / scale[1], (ndc[2] - offset[2]) / scale[2]};
+        }
+
+        // Projects every point to normalised device coordinates, splitting the work across threads.
+        // Throws std::invalid_argument if the arrays differ in length.
+        void project_all(std::span<const Vector<3, T>> points, std::span<Vector<3, T>> ndc) const {
+            if (points.size() != ndc.size())
+                throw std::invalid_argument("Cannot project points into an array of a different length");
+            parallel_for(points.size(), [&](size_t begin, size_t end) {
+                for (size_t n = begin; n < end; n++) ndc[n] = project(points[n]);
+            });
+        }
+    };
+}
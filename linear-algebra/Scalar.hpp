@@ -0,0 +1,43 @@
+#pragma once
+
+#include <type_traits>
+
+namespace LinearAlgebra {
+    // Describes a type which can be used for the values of Vectors and Matrices.
+    // Specialise for custom types such as fixed point numbers, setting is_scalar to true.
+    template<typename T>
+    struct ScalarTraits {
+        // Whether the type can be used as a scalar
+        static constexpr bool is_scalar = std::is_integral<T>::value || std::is_floating_point<T>::value;
+
+        // Type in which sums of products are accumulated
+        using Accumulator = T;
+    };
+
+#ifdef LINEAR_ALGEBRA_WIDE_ACCUMULATION
+    // Accumulate float reductions in double when wide accumulation is enabled. Set it with the CMake option of the same
+    // name rather than defining it by hand, so that every translation unit agrees on this specialisation.
+    template<>
+    struct ScalarTraits<float> {
+        static constexpr bool is_scalar = true;
+        using Accumulator = double;
+    };
+#endif
+
+#ifdef __FLT16_MAX__
+    // Half precision is intended for storage only, so is always accumulated at least in float
+    template<>
+    struct ScalarTraits<_Float16> {
+        static constexpr bool is_scalar = true;
+        using Accumulator = typename ScalarTraits<float>::Accumulator;
+    };
+#endif
+
+    // Concept satisfied by any type usable for the values of Vectors and Matrices
+    template<typename T>
+    concept Scalar = ScalarTraits<T>::is_scalar;
+
+    // The type in which sums of products of T are accumulated
+    template<typename T>
+    using accumulator_t = typename ScalarTraits<T>::Accumulator;
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include "Vector.hpp"
+#include "Matrix.hpp"
+#include "DualQuaternion.hpp"
+#include "Parallel.hpp"
+
+namespace LinearAlgebra {
+    // How bone transforms are blended at each vertex
+    enum class SkinningMode {
+        // Linear blend skinning. Blends the bone matrices. Fast, but collapses volume under large twists.
+        Linear,
+        // Dual quaternion skinning. Blends rigid transforms. Preserves volume but ignores scale and shear.
+        DualQuaternion
+    };
+
+    // The vertices to be skinned. Each vertex is influenced by up to 4 bones, indexing into the bone palette.
+    // Normals may be left empty, in which case only positions are skinned.
+    struct SkinningInput {
+        std::span<const Vec3> positions;
+        std::span<const Vec3> normals;
+        std::span<const Vec4u> bone_indices;
+        std::span<const Vec4> bone_weights;
+    };
+
+    // Skins every vertex by the bone palette, writing into positions and normals.
+    // Normals are transformed by the blended rotation and renormalised, which is exact for rigid and uniformly scaled
+    // bones. Work is split across the hardware threads. Under dual quaternion skinning a vertex whose weights blend to
+    // no rotation, such as one with every weight zero, has no transform to normalise and is left unchanged.
+    // Throws std::invalid_argument if the arrays differ in length or a bone index is outside the palette.
+    inline void skin_vertices(SkinningMode mode, std::span<const Mat4> palette, const SkinningInput &input,
+                              std::span<Vec3> positions, std::span<Vec3> normals = {}) {
+        size_t count = input.positions.size();
+        bool skin_normals = !input.normals.empty();
+        if (input.bone_indices.size() != count || input.bone_weights.size() != count || positions.size() != count ||
+            (skin_normals && (input.normals.size() != count || normals.size() != count)))
+            throw std::invalid_argument("Skinning arrays must all have one entry per vertex");
+        for (const auto &indices: input.bone_indices)
+            for (int b = 0; b < 4; b++)
+                if (indices[b] >= palette.size())
+                    throw std::invalid_argument("Bone index outside of the palette");
+
+        if (mode == SkinningMode::Linear) {
+            parallel_for(count, [&](size_t begin, size_t end) {
+                for (size_t v = begin; v < end; v++) {
+                    const Vec4u &indices = input.bone_indices[v];
+                    const Vec4 &weights = input.bone_weights[v];
+
+                    // Blend the upper 3x4 of each bone matrix then apply it once
+                    double m[3][4] = {};
+                    for (int b = 0; b < 4; b++) {
+                        const Mat4 &bone = palette[indices[b]];
+                        for (int i = 0; i < 3; i++)
+                            for (int j = 0; j < 4; j++)
+                                m[i][j] += weights[b] * bone[i][j];
+                    }
+
+                    const Vec3 &p = input.positions[v];
+                    for (int i = 0; i < 3; i++)
+                        positions[v][i] = m[i][0] * p[0] + m[i][1] * p[1] + m[i][2] * p[2] + m[i][3];
+
+                    if (skin_normals) {
+                        const Vec3 &n = input.normals[v];
+                        Vec3 skinned;
+                        for (int i = 0; i < 3; i++) skinned[i] = m[i][0] * n[0] + m[i][1] * n[1] + m[i][2] * n[2];
+                        normals[v] = skinned.normalised();
+                    }
+                }
+            });
+        } else {
+            std::vector<DualQuaternion> bones(palette.size());
+            for (size_t b = 0; b < palette.size(); b++) bones[b] = DualQuaternion::from_matrix(palette[b]);
+
+            parallel_for(count, [&](size_t begin, size_t end) {
+                for (size_t v = begin; v < end; v++) {
+                    const Vec4u &indices = input.bone_indices[v];
+                    const Vec4 &weights = input.bone_weights[v];
+
+                    // Flip bones into the same hemisphere as the first so the blend takes the short path
+                    const DualQuaternion &pivot = bones[indices[0]];
+                    DualQuaternion blend = DualQuaternion::multiply(weights[0], pivot);
+                    for (int b = 1; b < 4; b++) {
+                        const DualQuaternion &bone = bones[indices[b]];
+                        double w = Quaternion::dot_product(pivot.real, bone.real) < 0 ? -weights[b] : weights[b];
+                        blend = blend + DualQuaternion::multiply(w, bone);
+                    }
+                    // An empty blend cannot be normalised, so treat it as the identity
+                    if (Quaternion::dot_product(blend.real, blend.real) < 1e-24) blend = DualQuaternion();
+                    else blend.normalise();
+
+                    positions[v] = blend.transform_point(input.positions[v]);
+                    if (skin_normals) normals[v] = blend.transform_vector(input.normals[v]);
+                }
+            });
+        }
+    }
+}
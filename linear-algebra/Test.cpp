@@ -1,6 +1,25 @@
 #include <linear-algebra/Vector.hpp>
 #include <linear-algebra/Matrix.hpp>
 #include <linear-algebra/Orientation.hpp>
+#include <linear-algebra/MappedArray.hpp>
+#include <linear-algebra/PointStream.hpp>
+#include <linear-algebra/TransformHierarchy.hpp>
+#include <linear-algebra/DualQuaternion.hpp>
+#include <linear-algebra/Skinning.hpp>
+#include <linear-algebra/Compression.hpp>
+#include <linear-algebra/Projection.hpp>
+#include <linear-algebra/Bounds.hpp>
+#include <linear-algebra/Mesh.hpp>
+#include <linear-algebra/Orthonormalise.hpp>
+#include <linear-algebra/Integration.hpp>
+#include <linear-algebra/DynamicMatrix.hpp>
+#include <linear-algebra/DistributedMatrix.hpp>
+
+#include <climits>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
 
 #include <iostream>
 
@@ -245,6 +264,821 @@ namespace Test {
         TEST_ASSERT((v2 - v3).length() < FLOATING_POINT_ERROR_THRESHOLD);
         TEST_COMPLETE;
     }
+
+    bool MappedArray_round_trip() {
+        std::string path = (std::filesystem::temp_directory_path() / "linear-algebra-mapped-array.bin").string();
+        {
+            auto array = MappedArray<Mat3f>::create(path, 1000);
+            auto matrices = array.writable_elements();
+            for (unsigned int i = 0; i < matrices.size(); i++) matrices[i] = Mat3f::scaling(Vec3f{1, 2, (float) i});
+            array.flush();
+        }
+        auto array = MappedArray<Mat3f>::open(path);
+        TEST_ASSERT(array.size() == 1000);
+        TEST_ASSERT(array.header().data_offset % 64 == 0);
+        TEST_ASSERT(array.elements()[0] == Mat3f::scaling(Vec3f{1, 2, 0}));
+        TEST_ASSERT(array.elements()[999] == Mat3f::scaling(Vec3f{1, 2, 999}));
+        std::filesystem::remove(path);
+        TEST_COMPLETE;
+    }
+
+    bool MappedArray_type_checking() {
+        std::string path = (std::filesystem::temp_directory_path() / "linear-algebra-mapped-type.bin").string();
+        std::vector<Quaternion> quaternions{Quaternion(1, 2, 3, 4), Quaternion(5, 6, 7, 8)};
+        write_array<Quaternion>(path, quaternions);
+        TEST_ASSERT(MappedArray<Quaternion>::open(path).elements()[1] == Quaternion(5, 6, 7, 8));
+        bool rejected = false;
+        try {
+            MappedArray<Vec4>::open(path);
+        } catch (const std::runtime_error &) {
+            rejected = true;
+        }
+        TEST_ASSERT(rejected);
+
+        // A count large enough to overflow the size check must still be rejected
+        {
+            uint64_t count = UINT64_MAX / 4;
+            std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+            file.seekp(offsetof(ArrayFileHeader, count));
+            file.write(reinterpret_cast<const char *>(&count), sizeof(count));
+        }
+        rejected = false;
+        try {
+            MappedArray<Quaternion>::open(path);
+        } catch (const std::runtime_error &) {
+            rejected = true;
+        }
+        TEST_ASSERT(rejected);
+
+        // The same count must not wrap the size of a new file either
+        rejected = false;
+        try {
+            MappedArray<Quaternion>::create(path, UINT64_MAX / 4);
+        } catch (const std::invalid_argument &) {
+            rejected = true;
+        }
+        TEST_ASSERT(rejected);
+        std::filesystem::remove(path);
+        TEST_COMPLETE;
+    }
+
+    bool TransformPipeline_stream() {
+        TransformPipeline<double> pipeline;
+        pipeline.then(Mat4::scaling(Vec4{2, 2, 2, 1}))
+                .then(Quaternion::rotation(M_PI_2, Vec3{0, 0, 1}))
+                .then(Mat4::translating(Vec3{1, 0, 0}));
+
+        std::vector<Vec3> points;
+        for (int i = 0; i < 100; i++) points.push_back(Vec3{(double) i, 1, (double) -i});
+        std::stringstream in, out;
+        in.write(reinterpret_cast<const char *>(points.data()), (std::streamsize) (points.size() * sizeof(Vec3)));
+
+        TEST_ASSERT(pipeline.process(in, out, 7) == points.size());
+        std::vector<Vec3> transformed(points.size());
+        out.read(reinterpret_cast<char *>(transformed.data()), (std::streamsize) (points.size() * sizeof(Vec3)));
+        TEST_ASSERT(out.gcount() == (std::streamsize) (points.size() * sizeof(Vec3)));
+        for (unsigned int i = 0; i < points.size(); i++) {
+            Vec3 expected{1 - 2.0, 2.0 * i, -2.0 * i};
+            TEST_ASSERT((transformed[i] - expected).length() < FLOATING_POINT_ERROR_THRESHOLD);
+        }
+
+        // A stream whose reads fail must not be treated as an empty one
+        struct FailingBuffer : std::streambuf {
+            int_type underflow() override {
+                throw std::runtime_error("Device error");
+            }
+        } failing;
+        std::istream broken(&failing);
+        bool thrown = false;
+        try {
+            pipeline.process(broken, out, 7);
+        } catch (std::runtime_error &) {
+            thrown = true;
+        }
+        TEST_ASSERT(thrown);
+        TEST_COMPLETE;
+    }
+
+    bool TransformHierarchy_propagation() {
+        TransformHierarchy hierarchy;
+        unsigned int root = hierarchy.add_node(Mat4::translating(Vec3{1, 0, 0}));
+        unsigned int child = hierarchy.add_node(Mat4::translating(Vec3{0, 2, 0}), root);
+        unsigned int grandchild = hierarchy.add_node(Mat4::scaling(Vec4{2, 2, 2, 1}), child);
+        unsigned int other = hierarchy.add_node(Mat4::translating(Vec3{0, 0, 5}));
+        Vec4 origin{0, 0, 0, 1}, ones{1, 1, 1, 1};
+
+        TEST_ASSERT(hierarchy.world(grandchild) * ones == Vec4({3, 4, 2, 1}));
+        hierarchy.set_local(root, Vec3{-1, 0, 0}, Quaternion(1, 0, 0, 0), Vec3{1, 1, 1});
+        TEST_ASSERT(hierarchy.world(child) * origin == Vec4({-1, 2, 0, 1}));
+        TEST_ASSERT(hierarchy.world(grandchild) * ones == Vec4({1, 4, 2, 1}));
+        TEST_ASSERT(hierarchy.world(other) * origin == Vec4({0, 0, 5, 1}));
+        Vec4 restored = hierarchy.inverse_world(grandchild) * Vec4{1, 4, 2, 1};
+        TEST_ASSERT((restored - ones).length() < FLOATING_POINT_ERROR_THRESHOLD);
+        TEST_ASSERT(hierarchy.parent(grandchild) == child);
+        TEST_COMPLETE;
+    }
+
+    bool TransformHierarchy_single_root() {
+        // One root with several long chains below it, large enough to be split across threads
+        TransformHierarchy hierarchy;
+        unsigned int root = hierarchy.add_node(Mat4::translating(Vec3{0, 0, 1}));
+        std::vector<unsigned int> tips;
+        for (int chain = 0; chain < 4; chain++) {
+            unsigned int node = root;
+            for (int n = 0; n < 1000; n++) node = hierarchy.add_node(Mat4::translating(Vec3{1, 0, 0}), node);
+            tips.push_back(node);
+        }
+        Vec4 origin{0, 0, 0, 1};
+        for (unsigned int tip: tips) TEST_ASSERT(hierarchy.world(tip) * origin == Vec4({1000, 0, 1, 1}));
+
+        hierarchy.set_local(tips[1] - 500, Mat4::translating(Vec3{1, 3, 0}));
+        TEST_ASSERT(hierarchy.world(tips[0]) * origin == Vec4({1000, 0, 1, 1}));
+        TEST_ASSERT(hierarchy.world(tips[1]) * origin == Vec4({1000, 3, 1, 1}));
+
+        hierarchy.set_local(root, Mat4::translating(Vec3{0, 0, 2}));
+        for (unsigned int tip: tips) {
+            double y = tip == tips[1] ? 3 : 0;
+            TEST_ASSERT(hierarchy.world(tip) * origin == Vec4({1000, y, 2, 1}));
+        }
+        TEST_COMPLETE;
+    }
+
+    bool DualQuaternion_rigid_transform() {
+        DualQuaternion a = DualQuaternion::rigid(Quaternion::rotation(M_PI_2, Vec3{0, 0, 1}), Vec3{1, 2, 3});
+        DualQuaternion b = DualQuaternion::from_matrix(Mat4::translating(Vec3{0, 0, 1}) *
+                                                       Mat4(Quaternion::rotation(1.0, Vec3{1, 1, 0}).as_matrix()));
+        Vec3 p{4, 5, 6};
+        Vec4 h{4, 5, 6, 1};
+        Vec4 expected = a.as_matrix() * (b.as_matrix() * h);
+        Vec3 composed = (a * b).transform_point(p);
+        TEST_ASSERT((composed - Vec3{expected[0], expected[1], expected[2]}).length() < FLOATING_POINT_ERROR_THRESHOLD);
+        TEST_ASSERT((a.transform_point(p) - Vec3{-4, 6, 9}).length() < FLOATING_POINT_ERROR_THRESHOLD);
+        TEST_ASSERT(((a * a.conjugate()).transform_point(p) - p).length() < FLOATING_POINT_ERROR_THRESHOLD);
+        TEST_COMPLETE;
+    }
+
+    bool Skinning_blend_modes() {
+        std::vector<Mat4> palette{Mat4(), Mat4(Quaternion::rotation(M_PI_2, Vec3{0, 0, 1}).as_matrix())};
+        std::vector<Vec3> positions{Vec3{1, 0, 0}, Vec3{1, 0, 0}};
+        std::vector<Vec3> normals{Vec3{1, 0, 0}, Vec3{1, 0, 0}};
+        std::vector<Vec4u> indices{Vec4u{1, 0, 0, 0}, Vec4u{0, 1, 0, 0}};
+        std::vector<Vec4> weights{Vec4{1, 0, 0, 0}, Vec4{0.5, 0.5, 0, 0}};
+        SkinningInput input{positions, normals, indices, weights};
+        std::vector<Vec3> skinned(2), skinned_normals(2);
+
+        skin_vertices(SkinningMode::Linear, palette, input, skinned, skinned_normals);
+        TEST_ASSERT((skinned[0] - Vec3{0, 1, 0}).length() < FLOATING_POINT_ERROR_THRESHOLD);
+        TEST_ASSERT((skinned[1] - Vec3{0.5, 0.5, 0}).length() < FLOATING_POINT_ERROR_THRESHOLD);
+        TEST_ASSERT((skinned_normals[1] - Vec3{M_SQRT1_2, M_SQRT1_2, 0}).length() < FLOATING_POINT_ERROR_THRESHOLD);
+
+        skin_vertices(SkinningMode::DualQuaternion, palette, input, skinned, skinned_normals);
+        TEST_ASSERT((skinned[0] - Vec3{0, 1, 0}).length() < FLOATING_POINT_ERROR_THRESHOLD);
+        TEST_ASSERT((skinned[1] - Vec3{M_SQRT1_2, M_SQRT1_2, 0}).length() < FLOATING_POINT_ERROR_THRESHOLD);
+        TEST_ASSERT((skinned_normals[1] - Vec3{M_SQRT1_2, M_SQRT1_2, 0}).length() < FLOATING_POINT_ERROR_THRESHOLD);
+
+        // A vertex without any weight is passed through rather than normalising an empty blend
+        std::vector<Vec3> unskinned_positions{Vec3{2, 3, 4}}, unskinned_normals{Vec3{0, 1, 0}};
+        std::vector<Vec4u> unskinned_indices{Vec4u{0, 1, 0, 0}};
+        std::vector<Vec4> no_weights{Vec4{0, 0, 0, 0}};
+        SkinningInput unskinned{unskinned_positions, unskinned_normals, unskinned_indices, no_weights};
+        std::vector<Vec3> passed(1), passed_normals(1);
+        skin_vertices(SkinningMode::DualQuaternion, palette, unskinned, passed, passed_normals);
+        TEST_ASSERT(passed[0] == unskinned_positions[0] && passed_normals[0] == unskinned_normals[0]);
+        TEST_COMPLETE;
+    }
+
+    bool Compression_quaternions() {
+        std::vector<Quaternion> quaternions;
+        for (int n = 0; n < 100; n++) quaternions.push_back(Quaternion::rotation(n * 0.1, Vec3{1, (double) -n, 0.5}));
+        std::vector<PackedQuaternion32> small(quaternions.size());
+        std::vector<PackedQuaternion48> large(quaternions.size());
+        std::vector<Quaternion> decoded_small(quaternions.size()), decoded_large(quaternions.size());
+        encode_quaternions<PackedQuaternion32>(quaternions, small);
+        encode_quaternions<PackedQuaternion48>(quaternions, large);
+        decode_quaternions<PackedQuaternion32>(small, decoded_small);
+        decode_quaternions<PackedQuaternion48>(large, decoded_large);
+
+        TEST_ASSERT(sizeof(PackedQuaternion32) == 4 && sizeof(PackedQuaternion48) == 6);
+        // Either the quaternion or its negation may be decoded, both of which are the same rotation
+        auto error = [](const Quaternion &a, const Quaternion &b) {
+            return std::min((a.as_vector() - b.as_vector()).length(), (a.as_vector() + b.as_vector()).length());
+        };
+        for (unsigned int n = 0; n < quaternions.size(); n++) {
+            TEST_ASSERT(error(quaternions[n], decoded_small[n]) <= 2.5e-3);
+            TEST_ASSERT(error(quaternions[n], decoded_large[n]) <= 1e-4);
+        }
+        TEST_COMPLETE;
+    }
+
+    bool Compression_directions_and_positions() {
+        std::vector<Vec3> directions{Vec3{0, 0, 1}, Vec3{0, 0, -1}, Vec3{1, -2, 3}.normalised(),
+                                     Vec3{-4, 1, -1}.normalised()};
+        std::vector<PackedDirection> packed(directions.size());
+        std::vector<Vec3> decoded(directions.size());
+        encode_directions(directions, packed);
+        decode_directions(packed, decoded);
+        for (unsigned int n = 0; n < directions.size(); n++)
+            TEST_ASSERT((directions[n] - decoded[n]).length() < 1e-4);
+        TEST_ASSERT((PackedDirection::encode(Vec3{0, 0, 0}).decode() - Vec3{0, 0, 1}).length() == 0);
+
+        std::vector<Vec3> positions;
+        for (int n = 0; n < 1000; n++) positions.push_back(Vec3{n * 0.5, sin(n) * 10, -3.0});
+        std::vector<Vector<3, uint16_t>> quantised(positions.size());
+        std::vector<PositionBlock> blocks(position_block_count(positions.size(), 64));
+        std::vector<Vec3> restored(positions.size());
+        encode_positions(positions, quantised, blocks, 64);
+        decode_positions(quantised, blocks, restored, 64);
+        for (unsigned int n = 0; n < positions.size(); n++)
+            TEST_ASSERT((positions[n] - restored[n]).length() < 1e-3);
+        TEST_COMPLETE;
+    }
+
+    bool Matrix_exact_integer_elimination() {
+        Mat3i a{5, 9, 7,
+                4, 1, 6,
+                3, 8, 2};
+        TEST_ASSERT(a.determinant() == 63);
+        Mat3i swapped{0, 1, 0,
+                      1, 0, 0,
+                      0, 0, 1};
+        TEST_ASSERT(swapped.determinant() == -1);
+
+        // The symmetric Pascal matrix has a determinant of exactly 1
+        Matrix<5, 5, int> pascal([](unsigned int i, unsigned int j) {
+            int value = 1;
+            for (unsigned int k = 1; k <= j; k++) value = value * (i + k) / k;
+            return value;
+        });
+        TEST_ASSERT(pascal.exact_determinant() == 1);
+        TEST_ASSERT(pascal.rank() == 5);
+
+        Matrix<3, 4, int> dependent{1, 2, 3, 4,
+                                    2, 4, 6, 8,
+                                    1, 0, 1, 0};
+        TEST_ASSERT(dependent.rank() == 2);
+        Mat3u singular{1, 2, 3,
+                       4, 5, 6,
+                       7, 8, 9};
+        TEST_ASSERT(singular.rank() == 2);
+        TEST_ASSERT(singular.determinant() == 0);
+
+        auto[numerators, denominator] = a.solve_exact(Vec3i{1, 2, 3});
+        for (int i = 0; i < 3; i++) {
+            long long row = 0;
+            for (int j = 0; j < 3; j++) row += a[i][j] * numerators[j];
+            TEST_ASSERT(row == (i + 1) * denominator);
+        }
+        TEST_ASSERT(denominator == 63 || denominator == -63);
+        TEST_COMPLETE;
+    }
+
+    bool Matrix_non_square_multiplication() {
+        Matrix<2, 3, int> a{1, 2, 3,
+                            4, 5, 6};
+        Matrix<3, 2, int> b{7, 8,
+                            9, 10,
+                            11, 12};
+        Matrix<2, 2, int> c{58, 64,
+                            139, 154};
+        TEST_ASSERT(a * b == c);
+        Vec3i v{1, 0, -1};
+        TEST_ASSERT(a * v == Vec2i({-2, -2}));
+        TEST_COMPLETE;
+    }
+
+#ifdef __FLT16_MAX__
+    bool Half_precision_accumulation() {
+        // Half precision cannot represent 2049, so summing 4096 ones in half precision would stall at 2048
+        Vector<4096, _Float16> ones;
+        for (int i = 0; i < 4096; i++) ones[i] = 1;
+        TEST_ASSERT(ones.dot_product(ones) == (_Float16) 4096);
+        TEST_ASSERT(ones.length() == 64.0);
+
+        Matrix<1, 4096, _Float16> row([](unsigned int, unsigned int) { return (_Float16) 1; });
+        TEST_ASSERT((row * ones)[0] == (_Float16) 4096);
+        TEST_COMPLETE;
+    }
+#endif
+
+    bool Vector_fast_normalisation() {
+        Vector<3> a{6, 2, 5};
+        TEST_ASSERT(a.length_squared() == 65.0);
+        TEST_ASSERT(std::abs(a.normalised_fast().length() - 1.0) < 1e-12);
+        Vec3f b{1e-3f, -4e-3f, 2e-3f};
+        TEST_ASSERT(std::abs(b.normalised_fast().length() - 1.0) < 1e-6);
+        TEST_ASSERT(Vec3f().normalised_fast() == Vec3f());
+
+        // Lengths whose squares fall outside the range of float
+        TEST_ASSERT((Vec3{1e20, 0, 0}.normalised_fast() - Vec3{1, 0, 0}).length() < 1e-12);
+        TEST_ASSERT((Vec3{0, -1e-25, 0}.normalised_fast() - Vec3{0, -1, 0}).length() < 1e-12);
+        TEST_ASSERT((Vec3f{3e-20f, 0, 4e-20f}.normalised_fast() - Vec3f{0.6f, 0, 0.8f}).length() < 1e-6);
+
+        std::vector<Vec4f> vectors{Vec4f{1, 2, 3, 4}, Vec4f{}, Vec4f{-7, 0, 0, 0}};
+        normalise_all(std::span<Vec4f>(vectors));
+        TEST_ASSERT(std::abs(vectors[0].length() - 1.0) < 1e-6);
+        TEST_ASSERT(vectors[1] == Vec4f());
+        TEST_ASSERT(std::abs(vectors[2][0] + 1.0) < 1e-6);
+
+        std::vector<Quaternion> quaternions{Quaternion(1, 2, 3, 4), Quaternion()};
+        normalise_all(quaternions);
+        TEST_ASSERT(std::abs(quaternions[0].magnitude() - 1.0) < 1e-12);
+        TEST_ASSERT(quaternions[1] == Quaternion());
+        TEST_ASSERT(std::abs(Quaternion(0, 0, 3, 4).normalised().k - 0.8) < 1e-12);
+        TEST_COMPLETE;
+    }
+
+    bool Transformation_projection() {
+        Mat4 view = Mat4::look_at(Vec3{0, 0, 5}, Vec3{0, 0, 0}, Vec3{0, 1, 0});
+        Vec4 origin{0, 0, 0, 1};
+        TEST_ASSERT(((view * origin) - Vec4{0, 0, -5, 1}).length() < FLOATING_POINT_ERROR_THRESHOLD);
+
+        Mat4 dense = Mat4::perspective(M_PI_2, 2.0, 1.0, 100.0);
+        PerspectiveProjection<double> projection(M_PI_2, 2.0, 1.0, 100.0);
+        TEST_ASSERT(projection.as_matrix() == dense);
+
+        std::vector<Vec3> points{Vec3{1, 2, -3}, Vec3{-4, 0.5, -50}, Vec3{0, 0, -1}, Vec3{10, -10, -100}};
+        std::vector<Vec3> ndc(points.size());
+        projection.project_all(points, ndc);
+        for (unsigned int n = 0; n < points.size(); n++) {
+            Vec4 clip = dense * points[n].append(1);
+            Vec3 expected{clip[0] / clip[3], clip[1] / clip[3], clip[2] / clip[3]};
+            TEST_ASSERT((ndc[n] - expected).length() < FLOATING_POINT_ERROR_THRESHOLD);
+            TEST_ASSERT((projection.unproject(ndc[n]) - points[n]).length() < FLOATING_POINT_ERROR_THRESHOLD);
+        }
+        TEST_ASSERT(std::abs(ndc[2][2] + 1) < FLOATING_POINT_ERROR_THRESHOLD);
+        TEST_ASSERT(std::abs(ndc[3][2] - 1) < FLOATING_POINT_ERROR_THRESHOLD);
+
+        OrthographicProjection<double> orthographic(-2, 2, -1, 1, 0, 10);
+        TEST_ASSERT(orthographic.as_matrix() == Mat4::orthographic(-2, 2, -1, 1, 0, 10));
+        TEST_ASSERT((orthographic.project(Vec3{2, -1, -10}) - Vec3{1, -1, 1}).length() < FLOATING_POINT_ERROR_THRESHOLD);
+        TEST_ASSERT((orthographic.unproject(Vec3{1, -1, 1}) - Vec3{2, -1, -10}).length() < FLOATING_POINT_ERROR_THRESHOLD);
+        TEST_COMPLETE;
+    }
+
+    bool Bounds_transformation() {
+        Box3 box(Vec3{0, 0, 0}, Vec3{2, 1, 1});
+        Mat4 m = Mat4::translating(Vec3{10, 0, 0}) * Mat4(Quaternion::rotation(M_PI_2, Vec3{0, 0, 1}).as_matrix());
+        Box3 transformed = box.transformed(m);
+        TEST_ASSERT((transformed.min - Vec3{9, 0, 0}).length() < FLOATING_POINT_ERROR_THRESHOLD);
+        TEST_ASSERT((transformed.max - Vec3{10, 2, 1}).length() < FLOATING_POINT_ERROR_THRESHOLD);
+        TEST_ASSERT(box.transformed(Mat3::scaling(Vec3{-1, 1, 1})).min == Vec3({-2, 0, 0}));
+        TEST_ASSERT(box.contains(Vec3{1, 0.5, 1}) && !box.contains(Vec3{1, 0.5, 1.5}));
+        TEST_COMPLETE;
+    }
+
+    bool Bounds_frustum_culling() {
+        Mat4 view_projection = Mat4::perspective(M_PI_2, 1.0, 1.0, 100.0) *
+                               Mat4::look_at(Vec3{0, 0, 0}, Vec3{0, 0, -1}, Vec3{0, 1, 0});
+        auto frustum = Frustum<double>::from_matrix(view_projection);
+        TEST_ASSERT(frustum.intersects(Box3(Vec3{-1, -1, -11}, Vec3{1, 1, -9})));
+        TEST_ASSERT(!frustum.intersects(Box3(Vec3{-1, -1, 9}, Vec3{1, 1, 11})));
+        TEST_ASSERT(!frustum.intersects(Box3(Vec3{-1, -1, -300}, Vec3{1, 1, -200})));
+        TEST_ASSERT(frustum.intersects(Vec3{0, 0, -50}, 1.0));
+        TEST_ASSERT(!frustum.intersects(Vec3{60, 0, -50}, 1.0));
+
+        std::vector<double> min_x, min_y, min_z, max_x, max_y, max_z, radius;
+        for (int n = 0; n < 5000; n++) {
+            double x = (n % 97) - 48.0, y = (n % 13) - 6.0, z = (n % 211) - 150.0;
+            min_x.push_back(x), min_y.push_back(y), min_z.push_back(z);
+            max_x.push_back(x + 1), max_y.push_back(y + 2), max_z.push_back(z + 3);
+            radius.push_back((n % 5) * 0.5);
+        }
+        auto visible = frustum.cull(BoxArrays<double>{min_x, min_y, min_z, max_x, max_y, max_z});
+        auto visible_spheres = frustum.cull(SphereArrays<double>{min_x, min_y, min_z, radius});
+
+        std::vector<unsigned int> expected, expected_spheres;
+        for (unsigned int n = 0; n < min_x.size(); n++) {
+            if (frustum.intersects(Box3(Vec3{min_x[n], min_y[n], min_z[n]}, Vec3{max_x[n], max_y[n], max_z[n]})))
+                expected.push_back(n);
+            if (frustum.intersects(Vec3{min_x[n], min_y[n], min_z[n]}, radius[n]))
+                expected_spheres.push_back(n);
+        }
+        TEST_ASSERT(!expected.empty() && expected.size() < min_x.size());
+        TEST_ASSERT(visible == expected);
+        TEST_ASSERT(visible_spheres == expected_spheres);
+        TEST_COMPLETE;
+    }
+
+    bool Mesh_normals_and_tangents() {
+        std::vector<Vec3> positions{Vec3{0, 0, 0}, Vec3{2, 0, 0}, Vec3{0, 2, 0}, Vec3{0, 0, 1}, Vec3{1, 0, 0}};
+        std::vector<unsigned int> indices{0, 1, 2, 0, 3, 4};
+        std::vector<Vec3> normals(positions.size());
+        compute_vertex_normals(positions, indices, normals);
+        TEST_ASSERT((normals[0] - Vec3{0, 1, 4}.normalised()).length() < 1e-6);
+        TEST_ASSERT((normals[2] - Vec3{0, 0, 1}).length() < 1e-6);
+        TEST_ASSERT((normals[3] - Vec3{0, 1, 0}).length() < 1e-6);
+
+        std::vector<Vec3> quad{Vec3{0, 0, 0}, Vec3{1, 0, 0}, Vec3{1, 1, 0}, Vec3{0, 1, 0}};
+        std::vector<unsigned int> quad_indices{0, 1, 2, 0, 2, 3};
+        std::vector<Vec3> quad_normals(quad.size());
+        std::vector<Vec4> tangents(quad.size());
+        compute_vertex_normals(quad, quad_indices, quad_normals);
+
+        std::vector<Vec2> uvs{Vec2{0, 0}, Vec2{1, 0}, Vec2{1, 1}, Vec2{0, 1}};
+        compute_vertex_tangents(quad, uvs, quad_normals, quad_indices, tangents);
+        for (const auto &tangent: tangents) TEST_ASSERT((tangent - Vec4{1, 0, 0, 1}).length() < 1e-6);
+
+        std::vector<Vec2> mirrored{Vec2{0, 0}, Vec2{-1, 0}, Vec2{-1, 1}, Vec2{0, 1}};
+        compute_vertex_tangents(quad, mirrored, quad_normals, quad_indices, tangents);
+        for (const auto &tangent: tangents) TEST_ASSERT((tangent - Vec4{-1, 0, 0, -1}).length() < 1e-6);
+
+        // Two triangles of equal area with tangents along x and y, the first with its texture shrunk tenfold
+        std::vector<Vec3> fan{Vec3{0, 0, 0}, Vec3{1, 0, 0}, Vec3{0, 1, 0}, Vec3{0, 1, 0}, Vec3{-1, 0, 0}};
+        std::vector<unsigned int> fan_indices{0, 1, 2, 0, 3, 4};
+        std::vector<Vec2> fan_uvs{Vec2{0, 0}, Vec2{0.1, 0}, Vec2{0, 0.1}, Vec2{1, 0}, Vec2{0, 1}};
+        std::vector<Vec3> fan_normals(fan.size(), Vec3{0, 0, 1});
+        std::vector<Vec4> fan_tangents(fan.size());
+        compute_vertex_tangents(fan, fan_uvs, fan_normals, fan_indices, fan_tangents);
+        TEST_ASSERT((fan_tangents[0] - Vec4{M_SQRT1_2, M_SQRT1_2, 0, 1}).length() < 1e-6);
+        TEST_COMPLETE;
+    }
+
+    // Returns the largest entry of R^T R - I
+    template<typename T>
+    double orthonormality_error(const Matrix<3, 3, T> &r) {
+        Matrix<3, 3, T> product = r.transpose() * r;
+        double error = 0;
+        for (int i = 0; i < 3; i++)
+            for (int j = 0; j < 3; j++) error = std::max(error, std::abs(product[i][j] - (i == j ? 1.0 : 0.0)));
+        return error;
+    }
+
+    bool Matrix_orthonormalisation() {
+        Mat3 rotation = Quaternion::rotation(0.7, Vec3{1, 2, 3}).as_matrix();
+        Mat3 drifted = rotation + Mat3([](unsigned int i, unsigned int j) { return 1e-3 * (i + 2.0 * j - 2); });
+        TEST_ASSERT(orthonormality_error(drifted) > 1e-3);
+        TEST_ASSERT(orthonormality_error(drifted.orthonormalised()) < 1e-12);
+        TEST_ASSERT(orthonormality_error(drifted.polar_orthonormalised(3)) < 1e-12);
+        Mat3 corrected = drifted.polar_orthonormalised(3);
+        for (int i = 0; i < 3; i++)
+            TEST_ASSERT((corrected.column_as_vector(i) - rotation.column_as_vector(i)).length() < 1e-2);
+
+        std::vector<Mat3f> matrices(100, Mat3f([](unsigned int i, unsigned int j) {
+            return (i == j ? 1.0f : 0.0f) + 2e-3f * (float) (i * j);
+        }));
+        orthonormalise_all(matrices, OrthonormaliseMethod::Polar);
+        for (const auto &m: matrices) TEST_ASSERT(orthonormality_error(m) < 1e-5);
+        TEST_ASSERT(orthonormality_error(matrices[0].inverse() * matrices[0]) < 1e-5);
+
+        std::vector<Quaternion> quaternions(100, Quaternion(1.001, 0.002, 0, -0.003));
+        renormalise_all(quaternions);
+        for (const auto &q: quaternions) TEST_ASSERT(std::abs(q.magnitude() - 1) < 1e-12);
+        TEST_COMPLETE;
+    }
+
+    bool Quaternion_integration() {
+        std::vector<double> r(64, 1), i(64, 0), j(64, 0), k(64, 0);
+        std::vector<double> wx(64, 0), wy(64, 0), wz(64, M_PI_2);
+        std::vector<Mat3> rotations(64);
+        Quaternion single(1, 0, 0, 0), first_order(1, 0, 0, 0);
+        for (int step = 0; step < 100; step++) {
+            integrate_orientations({r, i, j, k}, {wx, wy, wz}, 0.01, IntegrationMethod::ExponentialMap, rotations);
+            single = integrate_orientation(single, Vec3{0, 0, M_PI_2}, 0.01);
+            first_order = integrate_orientation(first_order, Vec3{0, 0, M_PI_2}, 0.01, IntegrationMethod::FirstOrder);
+        }
+
+        Quaternion expected = Quaternion::rotation(M_PI_2, Vec3{0, 0, 1});
+        Quaternion batch(r[63], i[63], j[63], k[63]);
+        TEST_ASSERT((batch - expected).as_vector().length() < 1e-12);
+        TEST_ASSERT(batch == single);
+        TEST_ASSERT((first_order - expected).as_vector().length() < 1e-3);
+        Mat3 difference = rotations[10] - expected.as_matrix();
+        for (int row = 0; row < 3; row++) TEST_ASSERT(Vec3(difference[row]).length() < 1e-12);
+        TEST_COMPLETE;
+    }
+
+    bool Matrix_power_exponential_logarithm() {
+        Mat2i fibonacci{1, 1,
+                        1, 0};
+        TEST_ASSERT(fibonacci.pow(30)[0][1] == 832040);
+        TEST_ASSERT(fibonacci.pow(0) == Mat2i());
+        Mat2 scale = Mat2::scaling(Vec2{2, 4});
+        TEST_ASSERT(scale.pow(-2) == Mat2::scaling(Vec2{0.25, 0.0625}));
+
+        Mat3 system{2, 1, 1,
+                    1, 3, 2,
+                    1, 0, 0};
+        Matrix<3, 1> x = system.solve(Matrix<3, 1>{4, 5, 6});
+        Matrix<3, 1> b = system * x;
+        TEST_ASSERT(std::abs(b[0][0] - 4) + std::abs(b[1][0] - 5) + std::abs(b[2][0] - 6) < 1e-12);
+
+        Vec3 axis = Vec3{1, -2, 2}.normalised();
+        Mat3 rotation = Quaternion::rotation(1.2, axis).as_matrix();
+        Mat3 generator = Mat3::skew(axis * 1.2);
+        Mat3 rodrigues = generator.exp();
+        Mat3 logarithm = rotation.log();
+        for (int i = 0; i < 3; i++) {
+            TEST_ASSERT((Vec3(rodrigues[i]) - Vec3(rotation[i])).length() < 1e-12);
+            TEST_ASSERT((Vec3(logarithm[i]) - Vec3(generator[i])).length() < 1e-12);
+        }
+        Mat3 half_turn = Quaternion::rotation(M_PI - 1e-6, axis).as_matrix().log();
+        TEST_ASSERT((Vec3{half_turn[2][1], half_turn[0][2], half_turn[1][0]} - axis * (M_PI - 1e-6)).length() < 1e-6);
+        // Just inside the threshold of the near pi branch, where the axis is least well determined. The remaining
+        // error comes from recovering the angle with acos, which is poorly conditioned near pi.
+        Mat3 near_half_turn = Quaternion::rotation(M_PI - 9e-5, axis).as_matrix();
+        Mat3 round_trip = near_half_turn.log().exp();
+        for (int i = 0; i < 3; i++) TEST_ASSERT((Vec3(round_trip[i]) - Vec3(near_half_turn[i])).length() < 1e-10);
+
+        // A non-skew matrix takes the Pade path: exp of a diagonal matrix is the exponential of its diagonal
+        Mat3 diagonal = Mat3::scaling(Vec3{1, -2, 3.5});
+        Mat3 exponential = diagonal.exp();
+        TEST_ASSERT(std::abs(exponential[0][0] - std::exp(1.0)) < 1e-12);
+        TEST_ASSERT(std::abs(exponential[1][1] - std::exp(-2.0)) < 1e-12);
+        TEST_ASSERT(std::abs(exponential[2][2] / std::exp(3.5) - 1) < 1e-12);
+        Mat2 nilpotent{0, 1,
+                       0, 0};
+        TEST_ASSERT((nilpotent.exp() - Mat2{1, 1, 0, 1}).column_as_vector(1).length() < 1e-12);
+        TEST_COMPLETE;
+    }
+
+    bool DynamicMatrix_operations() {
+        MatX a(Mat3{8, 5, 3, 1, 6, 9, 2, 4, 7});
+        MatX b(Mat3{5, 9, 2, 6, 7, 4, 1, 3, 8});
+        TEST_ASSERT(a * b == MatX(Mat3{73, 116, 60, 50, 78, 98, 41, 67, 76}));
+        TEST_ASSERT((a + b).minus(b) == a);
+        TEST_ASSERT(a.transpose()(0, 1) == 1);
+
+        MatX rectangular(2, 3);
+        TEST_ASSERT(rectangular(0, 0) == 0 && rectangular.rows() == 2 && rectangular.columns() == 3);
+        TEST_ASSERT((rectangular * a).rows() == 2);
+        bool rejected = false;
+        try {
+            a * rectangular;
+        } catch (const std::invalid_argument &) {
+            rejected = true;
+        }
+        TEST_ASSERT(rejected);
+
+        MatX x = a.solve(b);
+        MatX residual = a * x - b;
+        for (unsigned int i = 0; i < 3; i++)
+            for (unsigned int j = 0; j < 3; j++) TEST_ASSERT(std::abs(residual(i, j)) < 1e-12);
+        TEST_COMPLETE;
+    }
+
+    bool Workspace_allocation_reuse() {
+        MatX a(64, 64), b(64, 64), c(64, 64);
+        for (unsigned int i = 0; i < 64; i++)
+            for (unsigned int j = 0; j < 64; j++) a(i, j) = i + j, b(i, j) = i * 0.5 - j, c(i, j) = 1;
+
+        const Arena &arena = Workspace::thread_arena();
+        MatX result;
+        size_t warm_up_allocations = 0;
+        for (int run = 0; run < 3; run++) {
+            Workspace workspace;
+            MatX product = a * b + c;
+            MatX solved = (product + MatX(64, 64).scale(1e4)).solve(c);
+            TEST_ASSERT(product.resource() == &arena && solved.resource() == &arena);
+            result = std::move(product);
+            if (run == 1) warm_up_allocations = arena.counters().upstream_allocations;
+        }
+        // The arena is only drawn on while warming up, after which the computation allocates nothing upstream
+        TEST_ASSERT(arena.counters().upstream_allocations == warm_up_allocations);
+        TEST_ASSERT(arena.counters().allocations >= 3 * 4);
+        TEST_ASSERT(result.resource() != &arena);
+        TEST_ASSERT(result(1, 2) == (a * b + c)(1, 2));
+
+        std::pmr::monotonic_buffer_resource buffer;
+        {
+            Workspace workspace(&buffer);
+            TEST_ASSERT((a * b).resource() == &buffer);
+        }
+        TEST_ASSERT((a * b).resource() == std::pmr::get_default_resource());
+        TEST_COMPLETE;
+    }
+
+    bool Arena_over_alignment() {
+        Arena arena(256);
+        TEST_ASSERT(arena.allocate(1, 1) != nullptr);
+        // Alignments stricter than the blocks are given must still be honoured, within a block and across a new one
+        for (size_t alignment: {64, 64, 128, 512}) {
+            void *pointer = arena.allocate(100, alignment);
+            TEST_ASSERT(reinterpret_cast<uintptr_t>(pointer) % alignment == 0);
+        }
+        TEST_ASSERT(arena.counters().upstream_allocations > 1);
+        TEST_COMPLETE;
+    }
+
+    bool Matrix_unrolled_kernels() {
+        // Unrolled sizes and sizes past the unroll limit must agree with the definition of each operation
+        Matrix<2, 3> a([](int i, int j) { return 1.0 + i * 3 + j; });
+        Matrix<3, 4> b([](int i, int j) { return (double) (i - j); });
+        Matrix<2, 4> product = a * b;
+        for (int i = 0; i < 2; i++) {
+            for (int j = 0; j < 4; j++) {
+                double expected = 0;
+                for (int k = 0; k < 3; k++) expected += a[i][k] * b[k][j];
+                TEST_ASSERT(product[i][j] == expected);
+            }
+        }
+
+        Matrix<3, 2> transpose = a.transpose();
+        for (int i = 0; i < 2; i++) for (int j = 0; j < 3; j++) TEST_ASSERT(transpose[j][i] == a[i][j]);
+
+        Matrix<5, 5> c([](int i, int j) { return 0.5 * i - j; });
+        Matrix<5, 5> d([](int i, int j) { return (double) (i * j % 3); });
+        Matrix<5, 5> large = c * d + c * 2.0;
+        for (int i = 0; i < 5; i++) {
+            for (int j = 0; j < 5; j++) {
+                double expected = 2.0 * c[i][j];
+                for (int k = 0; k < 5; k++) expected += c[i][k] * d[k][j];
+                TEST_ASSERT(std::abs(large[i][j] - expected) < FLOATING_POINT_ERROR_THRESHOLD);
+            }
+        }
+        TEST_ASSERT(c.transpose().transpose() == c);
+        TEST_ASSERT(c != d);
+
+        Mat4 overwritten(uninitialised);
+        for (int i = 0; i < 4; i++) for (int j = 0; j < 4; j++) overwritten[i][j] = i == j;
+        TEST_ASSERT(overwritten == Mat4());
+        Vec4 v(uninitialised);
+        for (int i = 0; i < 4; i++) v[i] = i;
+        TEST_ASSERT(overwritten * v == v);
+        TEST_ASSERT(v.dot_product(v) == 14);
+        TEST_COMPLETE;
+    }
+
+    bool Backend_kernels_agree() {
+        // Large enough to be handed to BLAS when it is available
+        const size_t n = 40, m = 56;
+        std::vector<double> a(n * n), b(n * m), tall(m * n), x(n), spd(n * n);
+        for (size_t i = 0; i < n * n; i++) a[i] = std::sin(1.3 * i);
+        for (size_t i = 0; i < n; i++) a[i * n + i] += 2.0 * n;
+        for (size_t i = 0; i < n * m; i++) b[i] = std::cos(0.7 * i);
+        for (size_t i = 0; i < m * n; i++) tall[i] = std::sin(0.9 * i * i + 0.2);
+        for (size_t i = 0; i < n; i++) x[i] = 1.0 / (i + 1);
+        // a + aᵀ is symmetric and diagonally dominant, so positive definite
+        for (size_t i = 0; i < n; i++) for (size_t j = 0; j < n; j++) spd[i * n + j] = a[i * n + j] + a[j * n + i];
+
+        std::vector<BackendKind> kinds{BackendKind::BuiltIn};
+        if (BLAS_AVAILABLE) kinds.push_back(BackendKind::Blas);
+        std::vector<std::vector<double>> results;
+        for (BackendKind kind: kinds) {
+            std::vector<double> product(n * m), image(n), factors(a), solution(b), lower(spd), q(m * n), r(n * n);
+            Backend::gemm(kind, n, n, m, a.data(), b.data(), product.data());
+            Backend::gemv(kind, n, n, a.data(), x.data(), image.data());
+            Backend::lu_solve(kind, n, factors.data(), m, solution.data());
+            Backend::cholesky(kind, n, lower.data());
+            Backend::qr(kind, m, n, tall.data(), q.data(), r.data());
+
+            // Every result must satisfy its definition, so each backend is also checked on its own
+            for (size_t i = 0; i < n; i++) {
+                for (size_t j = 0; j < m; j++) {
+                    double ab = 0;
+                    for (size_t k = 0; k < n; k++) ab += a[i * n + k] * solution[k * m + j];
+                    TEST_ASSERT(std::abs(ab - b[i * m + j]) < 1e-9);
+                }
+                for (size_t j = 0; j < n; j++) {
+                    double llt = 0;
+                    for (size_t k = 0; k < n; k++) llt += lower[i * n + k] * lower[j * n + k];
+                    TEST_ASSERT(std::abs(llt - spd[i * n + j]) < 1e-9);
+                }
+            }
+            for (size_t i = 0; i < m; i++) {
+                for (size_t j = 0; j < n; j++) {
+                    double qr = 0;
+                    for (size_t k = 0; k < n; k++) qr += q[i * n + k] * r[k * n + j];
+                    TEST_ASSERT(std::abs(qr - tall[i * n + j]) < 1e-9);
+                }
+            }
+
+            std::vector<double> all;
+            for (auto *result: {&product, &image, &solution, &lower, &q, &r})
+                all.insert(all.end(), result->begin(), result->end());
+            results.push_back(all);
+        }
+
+        for (size_t k = 1; k < results.size(); k++)
+            for (size_t i = 0; i < results[0].size(); i++)
+                TEST_ASSERT(std::abs(results[k][i] - results[0][i]) < 1e-9 * (1 + std::abs(results[0][i])));
+
+        // Large fixed size matrices are dispatched in the same way
+        Matrix<40, 40> fixed([&](int i, int j) { return a[i * n + j]; });
+        Matrix<40, 40> squared = fixed * fixed, recovered = fixed.solve(squared);
+        std::vector<double> expected(n * n);
+        BuiltIn::gemm(n, n, n, a.data(), a.data(), expected.data());
+        for (size_t i = 0; i < n * n; i++) {
+            TEST_ASSERT(std::abs(squared.data()[i] - expected[i]) < 1e-9 * (1 + std::abs(expected[i])));
+            TEST_ASSERT(std::abs(recovered.data()[i] - a[i]) < 1e-9);
+        }
+
+        if (!BLAS_AVAILABLE) {
+            bool thrown = false;
+            try {
+                Backend::gemv(BackendKind::Blas, n, n, a.data(), x.data(), b.data());
+            } catch (std::logic_error &) {
+                thrown = true;
+            }
+            TEST_ASSERT(thrown);
+        } else {
+            // Dimensions the Fortran int cannot hold are rejected before any memory is read
+            bool thrown = false;
+            try {
+                Backend::gemv(BackendKind::Blas, (size_t) INT_MAX + 1, n, a.data(), x.data(), b.data());
+            } catch (std::invalid_argument &) {
+                thrown = true;
+            }
+            TEST_ASSERT(thrown);
+        }
+        TEST_COMPLETE;
+    }
+
+    bool DynamicMatrix_factorisations() {
+        MatX a(48, 48), tall(60, 48), column(48, 1);
+        for (unsigned int i = 0; i < 48; i++) {
+            for (unsigned int j = 0; j < 48; j++) a(i, j) = std::cos(0.3 * i * j + i) + (i == j ? 100 : 0);
+            column(i, 0) = i - 20.0;
+        }
+        for (unsigned int i = 0; i < 60; i++)
+            for (unsigned int j = 0; j < 48; j++) tall(i, j) = std::sin(i * i + 2.0 * j * j);
+
+        MatX identity(48, 48);
+        MatX product = a.inverse() * a;
+        for (unsigned int i = 0; i < 48; i++)
+            for (unsigned int j = 0; j < 48; j++) TEST_ASSERT(std::abs(product(i, j) - identity(i, j)) < 1e-12);
+
+        MatX image = a * column;
+        for (unsigned int i = 0; i < 48; i++) {
+            double expected = 0;
+            for (unsigned int k = 0; k < 48; k++) expected += a(i, k) * column(k, 0);
+            TEST_ASSERT(std::abs(image(i, 0) - expected) < 1e-9);
+        }
+
+        MatX spd = a.transpose() * a;
+        MatX l = a.transpose().multiply_matrix(a).cholesky();
+        MatX reconstructed = l * l.transpose();
+        for (unsigned int i = 0; i < 48; i++) {
+            for (unsigned int j = 0; j < 48; j++) {
+                TEST_ASSERT(std::abs(reconstructed(i, j) - spd(i, j)) < 1e-8 * std::abs(spd(i, i)));
+                if (j > i) TEST_ASSERT(l(i, j) == 0);
+            }
+        }
+
+        auto [q, r] = tall.qr();
+        MatX orthogonal = q.transpose() * q, original = q * r;
+        for (unsigned int i = 0; i < 48; i++) {
+            TEST_ASSERT(r(i, i) >= 0);
+            for (unsigned int j = 0; j < 48; j++) TEST_ASSERT(std::abs(orthogonal(i, j) - identity(i, j)) < 1e-12);
+        }
+        for (unsigned int i = 0; i < 60; i++)
+            for (unsigned int j = 0; j < 48; j++) TEST_ASSERT(std::abs(original(i, j) - tall(i, j)) < 1e-12);
+
+        bool thrown = false;
+        try {
+            MatX(3, 3).scale(-1).cholesky();
+        } catch (std::invalid_argument &) {
+            thrown = true;
+        }
+        TEST_ASSERT(thrown);
+        TEST_COMPLETE;
+    }
+
+    bool DistributedMatrix_summa_multiply() {
+        // Sizes which are not multiples of the block size leave partial blocks at the edges
+        MatX a(30, 22), b(22, 17);
+        for (unsigned int i = 0; i < 30; i++) for (unsigned int j = 0; j < 22; j++) a(i, j) = std::sin(i + 0.5 * j);
+        for (unsigned int i = 0; i < 22; i++) for (unsigned int j = 0; j < 17; j++) b(i, j) = std::cos(0.3 * i * j);
+
+        ProcessGrid grid{2, 3};
+        auto distributed_a = DistributedMatrix<double>::scatter(a, 4, grid);
+        auto distributed_b = DistributedMatrix<double>::scatter(b, 4, grid);
+        TEST_ASSERT(distributed_a.gather() == a);
+        TEST_ASSERT(distributed_a(13, 9) == a(13, 9));
+        TEST_ASSERT(distributed_a.owner(13, 9) == 3 * 1 + 2);
+        TEST_ASSERT(distributed_a.local_rows(0) == 16 && distributed_a.local_rows(3) == 14);
+        TEST_ASSERT(distributed_a.local_columns(0) == 8 && distributed_a.local_columns(2) == 6);
+
+        MatX product = (distributed_a * distributed_b).gather(), expected = a * b;
+        TEST_ASSERT(product.rows() == 30 && product.columns() == 17);
+        for (unsigned int i = 0; i < 30; i++)
+            for (unsigned int j = 0; j < 17; j++) TEST_ASSERT(std::abs(product(i, j) - expected(i, j)) < 1e-12);
+
+        // Only a mutable matrix hands out mutable storage
+        const auto &constant_a = distributed_a;
+        TEST_ASSERT((std::is_same<decltype(constant_a.local_data(0)), const double *>::value));
+        TEST_ASSERT((std::is_same<decltype(constant_a(13, 9)), const double &>::value));
+        distributed_a(13, 9) = 5;
+        TEST_ASSERT(constant_a(13, 9) == 5);
+
+        bool thrown = false;
+        try {
+            distributed_a * distributed_a;
+        } catch (std::invalid_argument &) {
+            thrown = true;
+        }
+        TEST_ASSERT(thrown);
+
+        thrown = false;
+        try {
+            fork_workers(2, NumaTopology::detect(), [](unsigned int worker) {
+                if (worker == 1) throw std::runtime_error("Worker failure");
+            });
+        } catch (std::runtime_error &) {
+            thrown = true;
+        }
+        TEST_ASSERT(thrown);
+        TEST_COMPLETE;
+    }
 }
 
 int main() {
@@ -260,20 +1094,52 @@ int main() {
     TEST(Vector_angle_between)
     TEST(Vector_normalisation)
     TEST(Vector_cross_product)
+    TEST(Vector_fast_normalisation)
     TEST(Vector_data)
     TEST(Matrix_constructor)
     TEST(Matrix_multiplication)
     TEST(Matrix_determinant)
     TEST(Matrix_inverse)
     TEST(Matrix_data)
+    TEST(Matrix_exact_integer_elimination)
+    TEST(Matrix_orthonormalisation)
+    TEST(Matrix_power_exponential_logarithm)
+    TEST(DynamicMatrix_operations)
+    TEST(Workspace_allocation_reuse)
+    TEST(Arena_over_alignment)
+    TEST(Matrix_unrolled_kernels)
+    TEST(Backend_kernels_agree)
+    TEST(DynamicMatrix_factorisations)
+    TEST(DistributedMatrix_summa_multiply)
+    TEST(Matrix_non_square_multiplication)
+#ifdef __FLT16_MAX__
+    TEST(Half_precision_accumulation)
+#endif
     TEST(Transformation_translation)
     TEST(Transformation_scale)
     TEST(Transformation_rotation)
+    TEST(Transformation_projection)
+    TEST(Bounds_transformation)
+    TEST(Bounds_frustum_culling)
+    TEST(Mesh_normals_and_tangents)
     TEST(Quaternion_multiplication)
     TEST(Quaternion_rotation)
+    TEST(Quaternion_integration)
+    TEST(MappedArray_round_trip)
+    TEST(MappedArray_type_checking)
+    TEST(TransformPipeline_stream)
+    TEST(TransformHierarchy_propagation)
+    TEST(TransformHierarchy_single_root)
+    TEST(DualQuaternion_rigid_transform)
+    TEST(Skinning_blend_modes)
+    TEST(Compression_quaternions)
+    TEST(Compression_directions_and_positions)
 
-    if (success == total)
+    if (success == total) {
         std::cout << success << "/" << total << " passed!" << std::endl;
-    else
+        return 0;
+    } else {
         std::cerr << success << "/" << total << " passed!" << std::endl;
+        return 1;
+    }
 }
@@ -0,0 +1,198 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#include "Vector.hpp"
+#include "Matrix.hpp"
+#include "Orientation.hpp"
+#include "Parallel.hpp"
+
+namespace LinearAlgebra {
+    // A forest of transforms where each node's world matrix is its parent's world matrix times its local matrix.
+    // Nodes are stored flat with every parent before its children. World matrices are cached and only those
+    // below a changed local transform are recomputed, the first time any world matrix is requested after a change.
+    // The subtrees below each child of a root are independent, so they are updated in parallel, even within one tree.
+    class TransformHierarchy {
+    public:
+        // Parent index of a node at the root of a tree
+        static constexpr unsigned int NO_PARENT = ~0u;
+
+    private:
+        // Branch index of a root, which belongs to no branch
+        static constexpr unsigned int NO_BRANCH = ~0u;
+
+        std::vector<unsigned int> parents;
+        std::vector<Mat4> locals;
+        std::vector<Mat4> worlds;
+        std::vector<Mat4> inverse_worlds;
+        // Set on nodes whose world matrix must be recomputed
+        std::vector<uint8_t> dirty;
+        // Set on nodes whose cached inverse world matrix is stale
+        std::vector<uint8_t> inverse_dirty;
+        // The nodes of the subtree below each child of a root, in parent before child order
+        std::vector<std::vector<unsigned int>> branches;
+        // Index into branches of the branch containing each node, or NO_BRANCH for roots
+        std::vector<unsigned int> branch_of;
+        // The branches below each node. Only filled in for roots.
+        std::vector<std::vector<unsigned int>> root_branches;
+        // Set on branches containing a dirty node
+        std::vector<uint8_t> branch_dirty;
+        // The branches containing a dirty node, each listed once
+        std::vector<unsigned int> dirty_branches;
+        // The roots which are dirty, each listed once
+        std::vector<unsigned int> dirty_roots;
+
+        // Number of nodes each thread should be given by update. Smaller updates run on the calling thread, as
+        // starting a thread costs more than updating this many nodes.
+        static constexpr size_t NODES_PER_THREAD = 1024;
+
+        // Records that a branch contains a dirty node
+        void mark_branch(unsigned int branch) {
+            if (branch_dirty[branch]) return;
+            branch_dirty[branch] = 1;
+            dirty_branches.push_back(branch);
+        }
+
+        // Marks a node dirty, recording the root or branch that must be updated
+        void mark(unsigned int node) {
+            if (branch_of[node] != NO_BRANCH) mark_branch(branch_of[node]);
+            else if (!dirty[node]) dirty_roots.push_back(node);
+            dirty[node] = 1;
+        }
+
+        // Recomputes the dirty nodes of one branch, passing dirtiness down to children as it goes
+        void update_branch(const std::vector<unsigned int> &branch) {
+            for (unsigned int node: branch) {
+                unsigned int parent = parents[node];
+                if (dirty[parent]) dirty[node] = 1;
+                if (dirty[node]) {
+                    worlds[node] = worlds[parent] * locals[node];
+                    inverse_dirty[node] = 1;
+                }
+            }
+            for (unsigned int node: branch) dirty[node] = 0;
+        }
+
+        // Throws std::out_of_range if node does not exist
+        void check(unsigned int node) const {
+            if (node >= parents.size())
+                throw std::out_of_range("Transform hierarchy node does not exist");
+        }
+
+    public:
+        // Adds a node with the given local transform as a child of parent and returns its index.
+        // Throws std::out_of_range if parent does not exist.
+        unsigned int add_node(const Mat4 &local, unsigned int parent = NO_PARENT) {
+            if (parent != NO_PARENT) check(parent);
+
+            auto node = (unsigned int) parents.size();
+            parents.push_back(parent);
+            locals.push_back(local);
+            worlds.push_back(local);
+            inverse_worlds.emplace_back();
+            dirty.push_back(0);
+            inverse_dirty.push_back(1);
+            root_branches.emplace_back();
+
+            if (parent == NO_PARENT) {
+                branch_of.push_back(NO_BRANCH);
+            } else if (branch_of[parent] == NO_BRANCH) {
+                // A child of a root starts a new branch
+                branch_of.push_back((unsigned int) branches.size());
+                root_branches[parent].push_back(branch_of.back());
+                branches.push_back({node});
+                branch_dirty.push_back(0);
+            } else {
+                branch_of.push_back(branch_of[parent]);
+                branches[branch_of[parent]].push_back(node);
+            }
+
+            mark(node);
+            return node;
+        }
+
+        // Returns the number of nodes
+        size_t size() const {
+            return parents.size();
+        }
+
+        // Returns the parent of a node, or NO_PARENT for a root
+        unsigned int parent(unsigned int node) const {
+            check(node);
+            return parents[node];
+        }
+
+        // Returns the local transform of a node
+        const Mat4 &local(unsigned int node) const {
+            check(node);
+            return locals[node];
+        }
+
+        // Replaces the local transform of a node, invalidating it and everything below it
+        void set_local(unsigned int node, const Mat4 &local) {
+            check(node);
+            locals[node] = local;
+            mark(node);
+        }
+
+        // Replaces the local transform of a node with a scale, then rotation, then translation
+        void set_local(unsigned int node, const Vec3 &translation, const Quaternion &rotation, const Vec3 &scale) {
+            Mat4 local(rotation.as_matrix());
+            for (int i = 0; i < 3; i++) {
+                for (int j = 0; j < 3; j++) local[i][j] *= scale[j];
+                local[i][3] = translation[i];
+            }
+            set_local(node, local);
+        }
+
+        // Recomputes every world matrix invalidated since the last update. Dirty roots are updated first, then the
+        // branches with a dirty node are split across threads by node count, so that each thread is given a similar
+        // amount of work and small updates stay on the calling thread.
+        void update() {
+            if (dirty_roots.empty() && dirty_branches.empty()) return;
+
+            for (unsigned int root: dirty_roots) {
+                worlds[root] = locals[root];
+                inverse_dirty[root] = 1;
+                for (unsigned int branch: root_branches[root]) mark_branch(branch);
+            }
+
+            // Offset of the first node of each dirty branch, were their nodes laid end to end
+            std::vector<size_t> offsets(dirty_branches.size() + 1, 0);
+            for (size_t b = 0; b < dirty_branches.size(); b++)
+                offsets[b + 1] = offsets[b] + branches[dirty_branches[b]].size();
+
+            // Each range updates the branches which start inside it
+            parallel_for(offsets.back(), [this, &offsets](size_t begin, size_t end) {
+                auto b = (size_t) (std::lower_bound(offsets.begin(), offsets.end() - 1, begin) - offsets.begin());
+                for (; b < dirty_branches.size() && offsets[b] < end; b++) update_branch(branches[dirty_branches[b]]);
+            }, NODES_PER_THREAD);
+
+            for (unsigned int root: dirty_roots) dirty[root] = 0;
+            for (unsigned int branch: dirty_branches) branch_dirty[branch] = 0;
+            dirty_roots.clear();
+            dirty_branches.clear();
+        }
+
+        // Returns the world transform of a node
+        const Mat4 &world(unsigned int node) {
+            check(node);
+            update();
+            return worlds[node];
+        }
+
+        // Returns the inverse of the world transform of a node. Computed on first request and then cached.
+        // Throws std::invalid_argument if the world transform is singular.
+        const Mat4 &inverse_world(unsigned int node) {
+            check(node);
+            update();
+            if (inverse_dirty[node]) {
+                inverse_worlds[node] = worlds[node].inverse();
+                inverse_dirty[node] = 0;
+            }
+            return inverse_worlds[node];
+        }
+    };
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+
+namespace LinearAlgebra {
+    // Tag selecting the constructors of Vector and Matrix which leave the values uninitialised.
+    // Used for results whose every element is written straight after construction.
+    struct Uninitialised {
+        explicit Uninitialised() = default;
+    };
+
+    // Value of the uninitialised construction tag
+    inline constexpr Uninitialised uninitialised{};
+
+    // Largest iteration count which unroll expands in full. Larger counts become an ordinary loop.
+    inline constexpr unsigned int UNROLL_LIMIT = 16;
+
+    namespace Detail {
+        // Flattened so the body is inlined at every index even at -O2, where the inliner would otherwise keep
+        // larger bodies as calls and leave the kernels as a sequence of function calls
+        template<typename F, size_t... I>
+        [[gnu::flatten]] inline void unroll(F &f, std::index_sequence<I...>) {
+            (f((unsigned int) I), ...);
+        }
+    }
+
+    // Calls f(i) for every i from 0 to N - 1 in order. Small counts are expanded at compile time into straight line
+    // code with constant indices, so the kernels built on it have no loop counters or branches.
+    template<unsigned int N, typename F>
+    [[gnu::always_inline]] inline void unroll(F &&f) {
+        if constexpr (N <= UNROLL_LIMIT) Detail::unroll(f, std::make_index_sequence<N>());
+        else for (unsigned int i = 0; i < N; i++) f(i);
+    }
+
+    // Calls f(i, j) for every row i below H and column j below W in row major order. Expanded in full when there are
+    // at most UNROLL_LIMIT elements, otherwise an ordinary pair of loops.
+    template<unsigned int H, unsigned int W, typename F>
+    [[gnu::always_inline]] inline void unroll_2d(F &&f) {
+        if constexpr (H * W <= UNROLL_LIMIT) unroll<H * W>([&](unsigned int n) { f(n / W, n % W); });
+        else for (unsigned int i = 0; i < H; i++) for (unsigned int j = 0; j < W; j++) f(i, j);
+    }
+}
@@ -3,11 +3,15 @@
 #include <cmath>
 #include <vector>
 #include <array>
+#include <span>
+#include <tuple>
+#include "FastMath.hpp"
+#include "Scalar.hpp"
+#include "Unroll.hpp"
 
 namespace LinearAlgebra {
 // Vector of type T and size S
-    template<unsigned int S, typename T = double> requires std::is_integral<T>::value ||
-                                                           std::is_floating_point<T>::value
+    template<unsigned int S, typename T = double> requires Scalar<T>
     class Vector {
     private:
         // Array containing the values values
@@ -15,9 +19,12 @@ namespace LinearAlgebra {
     public:
         // Default constructor. Initialises all values to 0;
         Vector() {
-            for (int i = 0; i < S; i++) values[i] = 0;
+            unroll<S>([&](unsigned int i) { values[i] = 0; });
         };
 
+        // Creates a vector with uninitialised values, for results which are about to be overwritten
+        explicit Vector(Uninitialised) {}
+
         // Copy Constructor from array
         explicit Vector(std::array<T, S> &data) : values(data) {}
 
@@ -44,8 +51,9 @@ namespace LinearAlgebra {
 
         // Tests is 2 vectors are equal
         bool equals(const Vector &b) const {
-            for (int i = 0; i < S; i++) if ((*this)[i] != b[i]) return false;
-            return true;
+            bool equal = true;
+            unroll<S>([&](unsigned int i) { equal &= values[i] == b[i]; });
+            return equal;
         }
 
         // Operator overload for vector equality
@@ -60,8 +68,8 @@ namespace LinearAlgebra {
 
         // Returns the piecewise sum result of 2 vectors
         Vector plus(const Vector &b) const {
-            Vector sum;
-            for (int i = 0; i < S; i++) sum[i] = (*this)[i] + b[i];
+            Vector sum(uninitialised);
+            unroll<S>([&](unsigned int i) { sum[i] = values[i] + b[i]; });
             return sum;
         }
 
@@ -77,8 +85,8 @@ namespace LinearAlgebra {
 
         // Returns the piecewise difference of 2 vectors
         Vector minus(const Vector &b) const {
-            Vector difference;
-            for (int i = 0; i < S; i++) difference[i] = (*this)[i] - b[i];
+            Vector difference(uninitialised);
+            unroll<S>([&](unsigned int i) { difference[i] = values[i] - b[i]; });
             return difference;
         }
 
@@ -94,8 +102,8 @@ namespace LinearAlgebra {
 
         // Scales r vector by r given constant
         Vector scale(T m) const {
-            Vector scaled;
-            for (int i = 0; i < S; i++) scaled[i] = m * (*this)[i];
+            Vector scaled(uninitialised);
+            unroll<S>([&](unsigned int i) { scaled[i] = m * values[i]; });
             return scaled;
         }
 
@@ -116,8 +124,9 @@ namespace LinearAlgebra {
 
         // Normalises the vector
         void normalise() {
-            if ((*this).length() != 1.0)
-                (*this) = (*this).normalised();
+            double length = (*this).length();
+            if (length != 1.0)
+                (*this) = (*this).scale(1.0 / length);
         }
 
         // Returns r normalised copy of the vector
@@ -125,10 +134,34 @@ namespace LinearAlgebra {
             return (*this).scale(1.0 / (*this).length());
         }
 
-        // Returns the dot product of 2 vectors
-        T dot_product(const Vector &b) {
-            T accumulator = 0;
-            for (int i = 0; i < S; i++) accumulator += (*this)[i] * b[i];
+        // Returns r normalised copy of the vector using a single reduction and a fast reciprocal square root.
+        // The length of the result is within 1e-6 of 1. The zero vector is returned unchanged.
+        Vector normalised_fast() const {
+            static_assert(!std::is_integral<T>::value, "Cannot normalise an integral vector");
+            using F = std::conditional_t<std::is_same<T, float>::value, float, double>;
+
+            auto length_squared = (F) (*this).length_squared();
+            F inverse = reciprocal_sqrt(length_squared);
+            inverse = length_squared > 0 ? inverse : 0;
+
+            Vector normalised(uninitialised);
+            unroll<S>([&](unsigned int i) { normalised[i] = (T) ((F) values[i] * inverse); });
+            return normalised;
+        }
+
+        // Returns the dot product of 2 vectors. Accumulates in accumulator_t<T>.
+        T dot_product(const Vector &b) const {
+            accumulator_t<T> accumulator = 0;
+            unroll<S>([&](unsigned int i) { accumulator += (accumulator_t<T>) values[i] * (accumulator_t<T>) b[i]; });
+            return (T) accumulator;
+        }
+
+        // Returns the squared magnitude of the vector. Cheaper than length when only comparing magnitudes.
+        accumulator_t<T> length_squared() const {
+            accumulator_t<T> accumulator = 0;
+            unroll<S>([&](unsigned int i) {
+                accumulator += (accumulator_t<T>) values[i] * (accumulator_t<T>) values[i];
+            });
             return accumulator;
         }
 
@@ -185,7 +218,7 @@ namespace LinearAlgebra {
         Vector<S, T> cross_product(const Vector &b) {
             static_assert(S == 3, "Cross Product is not defined on vectors of size other than 3");
 
-            Vector<3, T> cross;
+            Vector<3, T> cross(uninitialised);
             cross[0] = (*this)[1] * b[2] - (*this)[2] * b[1];
             cross[1] = (*this)[2] * b[0] - (*this)[0] * b[2];
             cross[2] = (*this)[0] * b[1] - (*this)[1] * b[0];
@@ -208,6 +241,12 @@ namespace LinearAlgebra {
         return v * m;
     }
 
+    // Normalises every vector in place with normalised_fast
+    template<unsigned int S, typename T>
+    void normalise_all(std::span<Vector<S, T>> vectors) {
+        for (auto &v: vectors) v = v.normalised_fast();
+    }
+
     // Aliases for common types
     using Vec2 = Vector<2, double>;
     using Vec3 = Vector<3, double>;
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+namespace LinearAlgebra {
+    // A memory resource which hands out memory by bumping a pointer through blocks taken from an upstream resource.
+    // Deallocation does nothing; memory is reclaimed by rewinding to an earlier mark, and the blocks are kept so
+    // that repeating the same computation needs no further upstream allocations.
+    class Arena : public std::pmr::memory_resource {
+    public:
+        // Position in the arena which can be rewound to
+        struct Mark {
+            size_t block;
+            size_t offset;
+        };
+
+        // Counts of the work done by the arena
+        struct Counters {
+            // Allocations served from the arena
+            size_t allocations = 0;
+            // Bytes served from the arena
+            size_t bytes = 0;
+            // Blocks requested from the upstream resource
+            size_t upstream_allocations = 0;
+        };
+
+    private:
+        struct Block {
+            std::byte *data;
+            size_t size;
+            size_t alignment;
+        };
+
+        std::pmr::memory_resource *upstream;
+        std::vector<Block> blocks;
+        // Block currently being allocated from and the offset of the next free byte in it
+        size_t current = 0, offset = 0;
+        size_t initial_size;
+        Counters counts;
+
+        // Adds a block of at least size bytes, starting on a multiple of alignment, to the end of the block list
+        void grow(size_t size, size_t alignment = alignof(std::max_align_t)) {
+            size = std::max(size, blocks.empty() ? initial_size : blocks.back().size * 2);
+            alignment = std::max(alignment, alignof(std::max_align_t));
+            blocks.push_back({static_cast<std::byte *>(upstream->allocate(size, alignment)), size, alignment});
+            counts.upstream_allocations++;
+        }
+
+        // Returns every block to the upstream resource
+        void release() {
+            for (auto &block: blocks) upstream->deallocate(block.data, block.size, block.alignment);
+            blocks.clear();
+        }
+
+    protected:
+        void *do_allocate(size_t bytes, size_t alignment) override {
+            while (true) {
+                if (current < blocks.size()) {
+                    Block &block = blocks[current];
+                    // Aligns the address rather than the offset, as the block itself may be less strictly aligned
+                    auto address = reinterpret_cast<uintptr_t>(block.data) + offset;
+                    size_t aligned = offset + (alignment - address % alignment) % alignment;
+                    if (aligned + bytes <= block.size) {
+                        offset = aligned + bytes;
+                        counts.allocations++;
+                        counts.bytes += bytes;
+                        return block.data + aligned;
+                    }
+                    if (current + 1 < blocks.size()) {
+                        current++;
+                        offset = 0;
+                        continue;
+                    }
+                }
+                grow(bytes, alignment);
+                current = blocks.size() - 1;
+                offset = 0;
+            }
+        }
+
+        void do_deallocate(void *, size_t, size_t) override {}
+
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+            return this == &other;
+        }
+
+    public:
+        // Creates an empty arena whose first block will be initial_size bytes
+        explicit Arena(size_t initial_size = 1 << 16,
+                       std::pmr::memory_resource *upstream = std::pmr::new_delete_resource())
+                : upstream(upstream), initial_size(initial_size) {}
+
+        Arena(const Arena &) = delete;
+
+        Arena &operator=(const Arena &) = delete;
+
+        ~Arena() override {
+            release();
+        }
+
+        // Returns the current position in the arena
+        Mark mark() const {
+            return {current, offset};
+        }
+
+        // Frees everything allocated since the mark was taken. Rewinding to the very start merges the blocks into
+        // one large enough for everything, so the next run of the same computation fits in a single block.
+        void rewind(Mark mark) {
+            current = mark.block;
+            offset = mark.offset;
+            if (current == 0 && offset == 0 && blocks.size() > 1) {
+                size_t total = 0;
+                for (auto &block: blocks) total += block.size;
+                release();
+                grow(total);
+            }
+        }
+
+        // Returns the counts of the work done by the arena
+        const Counters &counters() const {
+            return counts;
+        }
+    };
+
+    // Routes the heap storage of dynamic matrices created on this thread into a memory resource while in scope.
+    // By default each thread's own arena is used, and everything allocated within the scope is freed in one step
+    // when it ends, so objects created in a workspace must not outlive it. Workspaces may be nested.
+    class Workspace {
+    private:
+        std::pmr::memory_resource *previous;
+        Arena *arena;
+        Arena::Mark start;
+
+        // The resource currently used on this thread, or null for the default resource
+        static std::pmr::memory_resource *&current() {
+            thread_local std::pmr::memory_resource *resource = nullptr;
+            return resource;
+        }
+
+    public:
+        // Enters a workspace using this thread's arena
+        Workspace() : previous(current()), arena(&thread_arena()), start(arena->mark()) {
+            current() = arena;
+        }
+
+        // Enters a workspace using the given memory resource, which is responsible for freeing its own memory
+        explicit Workspace(std::pmr::memory_resource *resource) : previous(current()), arena(nullptr), start() {
+            current() = resource;
+        }
+
+        Workspace(const Workspace &) = delete;
+
+        Workspace &operator=(const Workspace &) = delete;
+
+        ~Workspace() {
+            if (arena) arena->rewind(start);
+            current() = previous;
+        }
+
+        // Returns the memory resource dynamic matrices should allocate from on this thread
+        static std::pmr::memory_resource *resource() {
+            std::pmr::memory_resource *resource = current();
+            return resource ? resource : std::pmr::get_default_resource();
+        }
+
+        // Returns this thread's arena
+        static Arena &thread_arena() {
+            thread_local Arena arena;
+            return arena;
+        }
+    };
+}